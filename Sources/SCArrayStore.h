@@ -33,9 +33,31 @@
 /** Returns an initialized SCArrayStore given an array of objects and their default data definition. */
 - (id)initWithObjectsArray:(NSMutableArray *)array defaultDefiniton:(SCDataDefinition *)definition;
 
-/** The objects array storage managed by the memory store. */
+/** The objects array storage managed by the memory store. 
+ 
+ @warning objectsArray must only be accessed from the main thread. Use objectsSnapshot to read the store's objects from other threads. If you mutate objectsArray directly rather than through the store, call objectsArrayDidChange afterwards.
+ */
 @property (nonatomic, strong) NSMutableArray *objectsArray;
 
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/// @name Thread-Safe Reads
+//////////////////////////////////////////////////////////////////////////////////////////
+
+/** An immutable snapshot of the contents of objectsArray that can be safely read from any thread, even while the store is being modified. 
+ 
+ The snapshot is created at most once per objectsVersion and is shared by all its readers. Modifying the store never changes a snapshot that has already been returned, so background filtering, searching and sorting always operate on a consistent set of objects.
+ 
+ @note The snapshot shares its objects with objectsArray. Only the array itself is immutable, not the objects it holds.
+ */
+@property (nonatomic, readonly) NSArray *objectsSnapshot;
+
+/** The version of the contents of objectsArray. This value is incremented every time the store's objects change, and can be used to determine if a snapshot or any results derived from it are outdated. */
+@property (atomic, readonly) NSUInteger objectsVersion;
+
+/** Informs the store that objectsArray has been directly mutated, so that a new objectsSnapshot gets published. There is no need to call this method when the store's own methods are used to change its objects. */
+- (void)objectsArrayDidChange;
+
 @end
 
 
@@ -17,8 +17,25 @@
 #import <objc/runtime.h>
 
 
+
+@interface SCArrayStore ()
+
+@property (atomic, strong) NSArray *publishedObjectsSnapshot;   // nil until the first read after objectsArray changed
+@property (atomic, readwrite) NSUInteger objectsVersion;
+
+- (void)refreshBoundObjectsArray;
++ (NSArray *)objectsInSnapshot:(NSArray *)snapshot withFilterPredicate:(NSPredicate *)filterPredicate sortDescriptors:(NSArray *)sortDescriptors batchSize:(NSUInteger)batchSize batchOffset:(NSUInteger)batchOffset;
++ (NSUInteger)countObjectsInSnapshot:(NSArray *)snapshot withFilterPredicate:(NSPredicate *)filterPredicate;
+
+@end
+
+
+
 @implementation SCArrayStore
 
+@synthesize publishedObjectsSnapshot = _publishedObjectsSnapshot;
+@synthesize objectsVersion = _objectsVersion;
+
 
 
 + (instancetype)storeWithObjectsArray:(NSMutableArray *)array defaultDefiniton:(SCDataDefinition *)definition
@@ -30,7 +47,8 @@
 {
 	if( (self = [super init]) )
 	{
-        // initialize here
+        _publishedObjectsSnapshot = nil;
+        _objectsVersion = 0;
 	}
 	return self;
 }
@@ -60,17 +78,62 @@
 // overrides superclass
 - (void)setStoredData:(NSObject *)data
 {
-    // only set data of the correct type
-    if([data isKindOfClass:[NSMutableArray class]])
+    @synchronized(self)
     {
-        [super setStoredData:data];
+        // only set data of the correct type
+        if([data isKindOfClass:[NSMutableArray class]])
+        {
+            [super setStoredData:data];
+        }
+        else
+        {
+            [super setStoredData:nil];
+            
+            if(data)
+                SCDebugLog(@"Warning: SCArrayStore expecting NSMutableArray but got %@ instead. (Data: %@)", NSStringFromClass([data class]) , data);
+        }
+        
+        [self objectsArrayDidChange];
     }
-    else
+}
+
+- (NSArray *)objectsSnapshot
+{
+    // readers never wait on writers once a snapshot of the current version exists
+    NSArray *snapshot = self.publishedObjectsSnapshot;
+    if(snapshot)
+        return snapshot;
+    
+    @synchronized(self)
     {
-        [super setStoredData:nil];
-        
-        if(data)
-            SCDebugLog(@"Warning: SCArrayStore expecting NSMutableArray but got %@ instead. (Data: %@)", NSStringFromClass([data class]) , data);
+        snapshot = self.publishedObjectsSnapshot;
+        if(!snapshot)
+        {
+            snapshot = self.objectsArray ? [self.objectsArray copy] : [NSArray array];
+            self.publishedObjectsSnapshot = snapshot;
+        }
+    }
+    
+    return snapshot;
+}
+
+- (void)objectsArrayDidChange
+{
+    @synchronized(self)
+    {
+        self.publishedObjectsSnapshot = nil;
+        self.objectsVersion += 1;
+    }
+}
+
+- (void)refreshBoundObjectsArray
+{
+    if(_boundObject && _boundPropertyName)
+    {
+        id value = [self valueForPropertyName:_boundPropertyName inObject:_boundObject];
+        // only replace the array when the bound instance changed, so the published snapshot stays valid
+        if([value isKindOfClass:[NSMutableArray class]] && value != self.objectsArray)
+            self.objectsArray = value;
     }
 }
 
@@ -125,7 +188,11 @@
 // overrides superclass
 - (BOOL)insertObject:(NSObject *)object
 {
-    [self.objectsArray addObject:object];
+    @synchronized(self)
+    {
+        [self.objectsArray addObject:object];
+        [self objectsArrayDidChange];
+    }
     
     [_uninsertedObjects removeObjectIdenticalTo:object];
     
@@ -135,12 +202,16 @@
 // overrides superclass
 - (BOOL)deleteObject:(NSObject *)object
 {
-    NSUInteger index = [self.objectsArray indexOfObjectIdenticalTo:object];
-    
-    if(index == NSNotFound)
-        return FALSE;
-    //else
-    [self.objectsArray removeObjectAtIndex:index];
+    @synchronized(self)
+    {
+        NSUInteger index = [self.objectsArray indexOfObjectIdenticalTo:object];
+        
+        if(index == NSNotFound)
+            return FALSE;
+        //else
+        [self.objectsArray removeObjectAtIndex:index];
+        [self objectsArrayDidChange];
+    }
     
     return TRUE;
 }
@@ -148,7 +219,11 @@
 // overrides superclass
 - (BOOL)insertObject:(NSObject *)object atOrder:(NSUInteger)order
 {
-    [self.objectsArray insertObject:object atIndex:order];
+    @synchronized(self)
+    {
+        [self.objectsArray insertObject:object atIndex:order];
+        [self objectsArrayDidChange];
+    }
     
     return TRUE;
 }
@@ -160,15 +235,19 @@
 
 - (BOOL)changeOrderForObject:(NSObject *)object toOrder:(NSUInteger)toOrder subsetArray:(NSArray *)subsetArray
 {
-    NSUInteger index = [self.objectsArray indexOfObjectIdenticalTo:object];
-    if(index == NSNotFound)
-        return FALSE;
-    
-    if(index == toOrder)
-        return TRUE;
-    
-    [self.objectsArray removeObjectAtIndex:index];
-    [self.objectsArray insertObject:object atIndex:toOrder];
+    @synchronized(self)
+    {
+        NSUInteger index = [self.objectsArray indexOfObjectIdenticalTo:object];
+        if(index == NSNotFound)
+            return FALSE;
+        
+        if(index == toOrder)
+            return TRUE;
+        
+        [self.objectsArray removeObjectAtIndex:index];
+        [self.objectsArray insertObject:object atIndex:toOrder];
+        [self objectsArrayDidChange];
+    }
     
     return TRUE;
 }
@@ -176,55 +255,160 @@
 // overrides superclass
 - (NSArray *)fetchObjectsWithOptions:(SCDataFetchOptions *)fetchOptions
 {
-    if(_boundObject && _boundPropertyName)
+    [self refreshBoundObjectsArray];
+    
+    // synchronous fetches copy the live array, objectsArray may have been mutated without calling objectsArrayDidChange
+    NSArray *array = [NSMutableArray arrayWithArray:self.objectsArray];
+    if(!fetchOptions)
+        return array;
+    
+    NSArray *sortDescriptors = nil;
+    if(fetchOptions.sort && fetchOptions.sortKey)
+        sortDescriptors = [fetchOptions sortDescriptors];
+    
+    array = [SCArrayStore objectsInSnapshot:array withFilterPredicate:fetchOptions.filterPredicate sortDescriptors:sortDescriptors batchSize:fetchOptions.batchSize batchOffset:fetchOptions.batchCurrentOffset];
+    
+    if(fetchOptions.batchSize)
+        [fetchOptions incrementBatchOffset];
+    
+    return array;
+}
+
+// overrides superclass
+- (void)asynchronousFetchObjectsWithOptions:(SCDataFetchOptions *)fetchOptions success:(SCDataStoreFetchSuccess_Block)success_block failure:(SCDataStoreFailure_Block)failure_block noConnection:(SCNoConnection_Block)noConnection_block
+{
+    [self refreshBoundObjectsArray];
+    
+    // capture everything the fetch depends on before leaving the calling thread
+    NSArray *snapshot = self.objectsSnapshot;
+    NSPredicate *filterPredicate = fetchOptions.filterPredicate;
+    NSArray *sortDescriptors = nil;
+    if(fetchOptions.sort && fetchOptions.sortKey)
+        sortDescriptors = [fetchOptions sortDescriptors];
+    NSUInteger batchSize = fetchOptions.batchSize;
+    NSUInteger batchOffset = fetchOptions.batchCurrentOffset;
+    if(batchSize)
+        [fetchOptions incrementBatchOffset];
+    
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        NSArray *results = [SCArrayStore objectsInSnapshot:snapshot withFilterPredicate:filterPredicate sortDescriptors:sortDescriptors batchSize:batchSize batchOffset:batchOffset];
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self fetchObjectsSuccessful:results successBlock:success_block failure:failure_block];
+        });
+    });
+}
+
+// overrides superclass
+- (NSUInteger)countObjectsWithOptions:(SCDataFetchOptions *)fetchOptions
+{
+    [self refreshBoundObjectsArray];
+    
+    // evaluated against the live array, no copy needed on the calling thread
+    return [SCArrayStore countObjectsInSnapshot:self.objectsArray withFilterPredicate:fetchOptions.filterPredicate];
+}
+
+// overrides superclass
+- (void)asynchronousCountObjectsWithOptions:(SCDataFetchOptions *)fetchOptions success:(SCDataStoreCountSuccess_Block)success_block failure:(SCDataStoreFailure_Block)failure_block noConnection:(SCNoConnection_Block)noConnection_block
+{
+    [self refreshBoundObjectsArray];
+    
+    NSArray *snapshot = self.objectsSnapshot;
+    NSPredicate *filterPredicate = fetchOptions.filterPredicate;
+    
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        NSUInteger count = [SCArrayStore countObjectsInSnapshot:snapshot withFilterPredicate:filterPredicate];
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if(success_block)
+                success_block(count);
+        });
+    });
+}
+
++ (NSArray *)objectsInSnapshot:(NSArray *)snapshot withFilterPredicate:(NSPredicate *)filterPredicate sortDescriptors:(NSArray *)sortDescriptors batchSize:(NSUInteger)batchSize batchOffset:(NSUInteger)batchOffset
+{
+    NSArray *array = snapshot;
+    
+    if(filterPredicate)
     {
-        id value = [self valueForPropertyName:_boundPropertyName inObject:_boundObject];
-        if([value isKindOfClass:[NSMutableArray class]])
-            self.objectsArray = value;
+        @try
+        {
+            array = [array filteredArrayUsingPredicate:filterPredicate];
+        }
+        @catch (NSException * e)
+        {
+            SCDebugLog(@"Warning: Invalid filter predicate: %@.", filterPredicate);
+        }
     }
     
-    NSArray *array = [NSMutableArray arrayWithArray:self.objectsArray];
+    if(sortDescriptors)
+    {
+        @try
+        {
+            array = [array sortedArrayUsingDescriptors:sortDescriptors];
+        }
+        @catch (NSException * e)
+        {
+            SCDebugLog(@"Warning: Invalid sort descriptors: %@.", sortDescriptors);
+        }
+    }
     
-    if(fetchOptions)
+    if(batchSize)
     {
-        [fetchOptions filterMutableArray:(NSMutableArray *)array];
-        [fetchOptions sortMutableArray:(NSMutableArray *)array];
-        
-        if(fetchOptions.batchSize)
+        NSRange range = {batchOffset*batchSize, batchSize};
+        if(range.location > array.count)
         {
-            NSRange range = {fetchOptions.batchCurrentOffset*fetchOptions.batchSize, fetchOptions.batchSize};
-            if(range.location > array.count)
-            {
-                array = [NSArray array];  // empty array
-            }
-            else 
-            {
-                NSInteger delta = (range.location+range.length)-array.count;
-                if(delta > 0)
-                {
-                    range.length -= delta;
-                }
-                
-                array = [array subarrayWithRange:range];
-            }
-            
-            [fetchOptions incrementBatchOffset];
+            array = [NSArray array];  // empty array
+        }
+        else
+        {
+            range.length = MIN(range.length, array.count-range.location);
+            array = [array subarrayWithRange:range];
         }
     }
     
     return array;
 }
 
++ (NSUInteger)countObjectsInSnapshot:(NSArray *)snapshot withFilterPredicate:(NSPredicate *)filterPredicate
+{
+    if(!filterPredicate)
+        return snapshot.count;
+    
+    // evaluate the predicate in place instead of filtering into a new array
+    NSUInteger count = 0;
+    @try
+    {
+        for(NSObject *object in snapshot)
+        {
+            if([filterPredicate evaluateWithObject:object])
+                count++;
+        }
+    }
+    @catch (NSException * e)
+    {
+        SCDebugLog(@"Warning: Invalid filter predicate: %@.", filterPredicate);
+        count = snapshot.count;
+    }
+    
+    return count;
+}
+
 // overrides superclass
 - (void)setValue:(NSObject *)value forPropertyName:(NSString *)propertyName inObject:(NSObject *)object
 {
     if([SCUtilities isBasicDataTypeClass:[object class]])
     {
         // replace old data type object with new one
-        NSUInteger index = [self.objectsArray indexOfObjectIdenticalTo:object];
-        if(index != NSNotFound)
+        @synchronized(self)
         {
-            [self.objectsArray replaceObjectAtIndex:index withObject:value];
+            NSUInteger index = [self.objectsArray indexOfObjectIdenticalTo:object];
+            if(index != NSNotFound)
+            {
+                [self.objectsArray replaceObjectAtIndex:index withObject:value];
+                [self objectsArrayDidChange];
+            }
         }
     }
     else 
@@ -233,6 +417,54 @@
     }
 }
 
+// overrides superclass
+- (NSArray *)importObjects:(NSArray *)objects
+{
+    BOOL dictionaryDefinition = [self.defaultDataDefinition isKindOfClass:[SCDictionaryDefinition class]];
+    NSMutableArray *importedObjects = [NSMutableArray arrayWithCapacity:objects.count];
+    NSUInteger batchSize = self.importBatchSize ? self.importBatchSize : objects.count;
+    
+    for(NSUInteger batchStart=0; batchStart<objects.count; batchStart+=batchSize)
+    {
+        @autoreleasepool
+        {
+            NSUInteger batchEnd = MIN(batchStart+batchSize, objects.count);
+            for(NSUInteger i=batchStart; i<batchEnd; i++)
+            {
+                NSObject *object = [objects objectAtIndex:i];
+                if([object isKindOfClass:[NSDictionary class]])
+                {
+                    NSDictionary *values = (NSDictionary *)object;
+                    if(dictionaryDefinition)
+                    {
+                        object = [NSMutableDictionary dictionaryWithDictionary:values];
+                    }
+                    else
+                    {
+                        object = [self createNewObject];
+                        [_uninsertedObjects removeObjectIdenticalTo:object];
+                        [self setImportValues:values inObject:object];
+                    }
+                }
+                
+                if(object)
+                    [importedObjects addObject:object];
+            }
+        }
+    }
+    
+    // mutate the array only once
+    @synchronized(self)
+    {
+        [self.objectsArray addObjectsFromArray:importedObjects];
+        [self objectsArrayDidChange];
+    }
+    
+    [self didImportObjects:importedObjects];
+    
+    return importedObjects;
+}
+
 - (BOOL)validateInsertForObject:(NSObject *)object
 {
     return TRUE;
@@ -1190,4 +1190,7 @@ typedef UIImage*(^SCImagePickerLoadImageAction_Block)(SCImagePickerCell *imagePi
  */
 - (void)setActionsTo:(SCCellActions *)actions overrideExisting:(BOOL)override;
 
+/** Incremented every time any 'SCCellActions' instance is assigned a valueIsValid action, so that sections tracking their cells' validity know to recalculate it. Method called internally. */
++ (NSUInteger)valueIsValidActionsGeneration;
+
 @end
@@ -11,8 +11,14 @@
 #import "SCCellActions.h"
 #import "SCGlobals.h"
 
+
+static NSUInteger _valueIsValidActionsGeneration = 0;
+
+
 @implementation SCCellActions
 
+@synthesize valueIsValid = _valueIsValid;
+
 
 - (instancetype)init
 {
@@ -26,6 +32,19 @@
 
 
 
++ (NSUInteger)valueIsValidActionsGeneration
+{
+    return _valueIsValidActionsGeneration;
+}
+
+- (void)setValueIsValid:(SCBOOLReturnCellAction_Block)valueIsValid
+{
+    _valueIsValid = [valueIsValid copy];
+    
+    // custom validation may depend on other cells, invalidate all tracked value states
+    _valueIsValidActionsGeneration++;
+}
+
 - (void)setActionsTo:(SCCellActions *)actions overrideExisting:(BOOL)override
 {
     if((override || !self.willStyle) && actions.willStyle)
@@ -13,6 +13,35 @@
 #import <objc/runtime.h>
 
 
+/* Immutable runtime metadata for a single key path of a class. Templates are interned process wide so that definitions created for an already-seen class never go back to the Objective-C runtime. */
+@interface SCClassPropertyTemplate : NSObject
+
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, copy) NSString *title;
+@property (nonatomic, readwrite) BOOL valid;
+@property (nonatomic, readwrite) BOOL dataReadOnly;
+@property (nonatomic, readwrite) SCDataType dataType;
+@property (nonatomic, copy) NSString *missingPropertyName;
+@property (nonatomic, strong) Class missingPropertyClass;
+
+@end
+
+
+@implementation SCClassPropertyTemplate
+
+@end
+
+
+
+
+@interface SCClassDefinition ()
+
++ (SCClassPropertyTemplate *)propertyTemplateForKeyPath:(NSString *)keyPath inClass:(Class)aClass;
++ (NSArray *)autoGeneratedPropertyTemplatesForClass:(Class)aClass;
+
+@end
+
+
 
 @implementation SCClassDefinition
 
@@ -44,12 +73,10 @@
 }
 
 
-// overrides superclass
-- (SCDataType)propertyDataTypeForPropertyWithName:(NSString *)propertyName
++ (SCDataType)dataTypeForProperty:(objc_property_t)property
 {
 	SCDataType dataType = SCDataTypeUnknown;
 	
-    objc_property_t property = class_getProperty(self.cls, [propertyName UTF8String]);
     if(!property)
         return SCDataTypeUnknown;
     NSArray *attributesArray = [[NSString stringWithUTF8String: property_getAttributes(property)] 
@@ -88,6 +115,111 @@
 	return dataType;
 }
 
++ (SCClassPropertyTemplate *)propertyTemplateForKeyPath:(NSString *)keyPath inClass:(Class)aClass
+{
+    static NSMutableDictionary *_templateCache = nil;  // class -> (key path -> template)
+    
+    if(!keyPath || !aClass)
+        return nil;
+    
+    @synchronized(self)
+    {
+        if(!_templateCache)
+            _templateCache = [NSMutableDictionary dictionary];
+        
+        NSMutableDictionary *classTemplates = [_templateCache objectForKey:(id<NSCopying>)aClass];
+        if(!classTemplates)
+        {
+            classTemplates = [NSMutableDictionary dictionary];
+            [_templateCache setObject:classTemplates forKey:(id<NSCopying>)aClass];
+        }
+        
+        SCClassPropertyTemplate *template = [classTemplates objectForKey:keyPath];
+        if(!template)
+        {
+            template = [[SCClassPropertyTemplate alloc] init];
+            template.name = keyPath;
+            template.title = [SCUtilities getUserFriendlyTitleFromName:keyPath];
+            template.dataType = [self dataTypeForProperty:class_getProperty(aClass, [keyPath UTF8String])];
+            template.valid = TRUE;
+            
+            Class _class = aClass;
+            objc_property_t property = NULL;
+            NSArray *keyPathArray = [keyPath componentsSeparatedByString:@"."];
+            for(NSUInteger i=0; i<keyPathArray.count; i++)
+            {
+                NSString *propertyName = [keyPathArray objectAtIndex:i];
+                property = class_getProperty(_class, [propertyName UTF8String]);
+                if(!property)
+                {
+                    template.valid = FALSE;
+                    template.missingPropertyName = propertyName;
+                    template.missingPropertyClass = _class;
+                    break;
+                }
+                if(i<keyPathArray.count-1)  // if not last property in keyPath
+                {
+                    NSArray *attributesArray = [[NSString stringWithUTF8String:property_getAttributes(property)] 
+                                                componentsSeparatedByString:@","];
+                    NSString *typeDescription = [attributesArray objectAtIndex:0];
+                    _class = nil;
+                    if(typeDescription.length > 4)
+                        _class = NSClassFromString([typeDescription substringWithRange:NSMakeRange(3, typeDescription.length-4)]);
+                }
+            }
+            if(template.valid)
+            {
+                NSArray *attributesArray = [[NSString stringWithUTF8String: property_getAttributes(property)] 
+                                            componentsSeparatedByString:@","];
+                template.dataReadOnly = [attributesArray containsObject:@"R"];
+            }
+            
+            [classTemplates setObject:template forKey:keyPath];
+        }
+        
+        return template;
+    }
+}
+
++ (NSArray *)autoGeneratedPropertyTemplatesForClass:(Class)aClass
+{
+    static NSMutableDictionary *_autoGeneratedTemplates = nil;  // class -> array of templates
+    
+    if(!aClass)
+        return nil;
+    
+    @synchronized(self)
+    {
+        if(!_autoGeneratedTemplates)
+            _autoGeneratedTemplates = [NSMutableDictionary dictionary];
+        
+        NSArray *templates = [_autoGeneratedTemplates objectForKey:(id<NSCopying>)aClass];
+        if(!templates)
+        {
+            NSMutableArray *classTemplates = [NSMutableArray array];
+            unsigned int count = 0; 
+            objc_property_t *properties = class_copyPropertyList(aClass, &count);
+            for (unsigned int i = 0; i < count; i++ )
+            {	
+                NSString *propertyName = [NSString stringWithUTF8String: property_getName(properties[i])];
+                [classTemplates addObject:[self propertyTemplateForKeyPath:propertyName inClass:aClass]];
+            }
+            free(properties);
+            
+            templates = [NSArray arrayWithArray:classTemplates];
+            [_autoGeneratedTemplates setObject:templates forKey:(id<NSCopying>)aClass];
+        }
+        
+        return templates;
+    }
+}
+
+// overrides superclass
+- (SCDataType)propertyDataTypeForPropertyWithName:(NSString *)propertyName
+{
+	return [[SCClassDefinition propertyTemplateForKeyPath:propertyName inClass:self.cls] dataType];
+}
+
 
 - (instancetype) init
 {
@@ -106,16 +238,12 @@
 		
 		if(autoGenerate)
 		{
-			unsigned int count = 0; 
-			objc_property_t *properties = class_copyPropertyList(self.cls, &count);
-			for (unsigned int i = 0; i < count; i++ )
-			{	
-				NSString *propertyName = [NSString stringWithUTF8String: property_getName(properties[i])];
-				[self addPropertyDefinitionWithName:propertyName 
-											  title:[SCUtilities getUserFriendlyTitleFromName:propertyName] 
+			for(SCClassPropertyTemplate *template in [SCClassDefinition autoGeneratedPropertyTemplatesForClass:self.cls])
+			{
+				[self addPropertyDefinitionWithName:template.name 
+											  title:template.title 
 											   type:SCPropertyTypeAutoDetect];
 			}
-			free(properties);
 		}
 		
 		[self setupDefaultConfiguration];
@@ -206,6 +334,8 @@
         if(i < propertyTitlesArray.count)
             propertyTitle = [propertyTitlesArray objectAtIndex:i];
         else
+            propertyTitle = [[SCClassDefinition propertyTemplateForKeyPath:propertyName inClass:self.cls] title];
+        if(!propertyTitle)
             propertyTitle = [SCUtilities getUserFriendlyTitleFromName:propertyName];
         [self addPropertyDefinitionWithName:propertyName
                                       title:propertyTitle
@@ -226,41 +356,15 @@
 	if(![propertyDefinition isKindOfClass:[SCCustomPropertyDefinition class]])
 	{
 		// determine property's data type
-        // Get class and propertyName
-        Class _class = self.cls;
-        NSString *propertyName = nil;
-        NSArray *keyPathArray = [propertyDefinition.name componentsSeparatedByString:@"."];
-        for(NSUInteger i=0; i<keyPathArray.count; i++)
-        {
-            propertyName = [keyPathArray objectAtIndex:i];
-            objc_property_t property = class_getProperty(_class, [propertyName UTF8String]);
-            if(!property)
-            {
-                SCDebugLog(@"Warning: Property '%@' does not exist in class '%@'.", propertyName, NSStringFromClass(_class));
-                return FALSE;
-            }
-            if(i<keyPathArray.count-1)  // if not last property in keyPath
-            {
-                NSArray *attributesArray = [[NSString stringWithUTF8String:property_getAttributes(property)] 
-                                            componentsSeparatedByString:@","];
-                NSString *typeDescription = [attributesArray objectAtIndex:0];
-                NSString *className = [typeDescription substringWithRange:NSMakeRange(3, typeDescription.length-4)];
-                _class = NSClassFromString(className);
-            }
-        }
-        
-        // Set property's dataType & dataReadOnly properties
-        objc_property_t property = class_getProperty(_class, [propertyName UTF8String]);
-        if(!property)
+        SCClassPropertyTemplate *template = [SCClassDefinition propertyTemplateForKeyPath:propertyDefinition.name inClass:self.cls];
+        if(!template.valid)
         {
-            SCDebugLog(@"Warning: Property '%@' does not exist in class '%@'.", propertyName, NSStringFromClass(_class));
+            SCDebugLog(@"Warning: Property '%@' does not exist in class '%@'.", template.missingPropertyName, NSStringFromClass(template.missingPropertyClass));
             return FALSE;
         }
-        NSArray *attributesArray = [[NSString stringWithUTF8String: property_getAttributes(property)] 
-                                    componentsSeparatedByString:@","];
-        NSSet *attributesSet = [NSSet setWithArray:attributesArray];
         
-        propertyDefinition.dataReadOnly = [attributesSet containsObject:@"R"];
+        // Set property's dataType & dataReadOnly properties
+        propertyDefinition.dataReadOnly = template.dataReadOnly;
         propertyDefinition.dataType = [self propertyDataTypeForPropertyWithName:propertyDefinition.name];
 	}
     
@@ -270,32 +374,7 @@
 // overrides superclass
 - (BOOL)isValidPropertyName:(NSString *)propertyName
 {
-	BOOL valid = TRUE;
-    
-    NSArray *keyPathArray = [propertyName componentsSeparatedByString:@"."];
-    NSString *pname = nil;
-    
-    Class _class = self.cls;
-    for(NSUInteger i=0; i<keyPathArray.count; i++)
-    {
-        pname = [keyPathArray objectAtIndex:i];
-        objc_property_t property = class_getProperty(_class, [pname UTF8String]);
-        if(!property)
-        {
-            valid = FALSE;
-            break;
-        }
-        if(i<keyPathArray.count-1)  // if not last property in keyPath
-        {
-            NSArray *attributesArray = [[NSString stringWithUTF8String:property_getAttributes(property)] 
-                                        componentsSeparatedByString:@","];
-            NSString *typeDescription = [attributesArray objectAtIndex:0];
-            NSString *className = [typeDescription substringWithRange:NSMakeRange(3, typeDescription.length-4)];
-            _class = NSClassFromString(className);
-        }
-    }
-    
-    return valid;
+	return [[SCClassDefinition propertyTemplateForKeyPath:propertyName inClass:self.cls] valid];
 }
 
 // overrides superclass
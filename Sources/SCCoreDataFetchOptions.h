@@ -22,6 +22,7 @@
 @interface SCCoreDataFetchOptions : SCDataFetchOptions
 {
     NSString *_orderAttributeName;
+    NSArray *_relationshipKeyPathsForPrefetching;
 }
 
 /**	The name of the attribute that will be used to determine the fetch order of the objects. 
@@ -30,4 +31,10 @@
  */
 @property (nonatomic, copy) NSString *orderAttributeName;
 
+/**	Additional key paths that SCCoreDataStore should take into account when prefetching relationships and determining the properties to fetch, such as the key paths read by a sectionHeaderTitleForItem model action. Key paths the store already derives from the entity definition don't need to be included here.
+ 
+ @see [SCCoreDataStore prefetchesDisplayedRelationships]
+ */
+@property (nonatomic, copy) NSArray *relationshipKeyPathsForPrefetching;
+
 @end
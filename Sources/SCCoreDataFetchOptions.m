@@ -12,6 +12,7 @@
 @implementation SCCoreDataFetchOptions
 
 @synthesize orderAttributeName = _orderAttributeName;
+@synthesize relationshipKeyPathsForPrefetching = _relationshipKeyPathsForPrefetching;
 
 
 - (instancetype)init
@@ -19,6 +20,7 @@
 	if( (self = [super init]) )
 	{
         _orderAttributeName = nil;
+        _relationshipKeyPathsForPrefetching = nil;
 	}
 	return self;
 }
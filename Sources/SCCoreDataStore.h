@@ -73,5 +73,20 @@
 /** When TRUE, objects removed from boundSet will also be removed from the data store. */
 @property (nonatomic, readonly) BOOL boundSetOwnsStoreObjects;
 
+/** When TRUE, the store observes its managedObjectContext for changes made outside the framework (e.g. saves merged from other contexts or CloudKit imports) and notifies its sections so that they can update only the affected rows without a full refetch. Default: TRUE. */
+@property (nonatomic, readwrite) BOOL tracksContextChanges;
+
+/** When TRUE, importObjects: inserts arrays of dictionaries using a single NSBatchInsertRequest (iOS 13 and up) instead of creating managed objects in the context. This is only used when the store is not bound to a relationship, all the persistent stores are SQLite stores and the dictionaries only contain attribute values. Batch inserts bypass managed object validation. Default: FALSE. */
+@property (nonatomic, readwrite) BOOL usesBatchInsertRequests;
+
+/** When TRUE, fetch requests prefetch the relationships traversed by the key paths the store's sections display and sort by (the entity definition's titlePropertyName, descriptionPropertyName and keyPropertyName, the fetch options' sort key, and any key paths in [SCCoreDataFetchOptions relationshipKeyPathsForPrefetching]). This fetches the related objects of a whole batch in one round trip instead of firing one fault per row while scrolling (e.g. a title of 'department.name'). Default: TRUE. */
+@property (nonatomic, readwrite) BOOL prefetchesDisplayedRelationships;
+
+/** When TRUE, fetch requests only fetch the attributes and to-one relationships named by the key paths described in prefetchesDisplayedRelationships. The remaining attributes are fetched on demand when first accessed, such as when the object's detail view is displayed. Partial fetching is skipped for entities whose displayed key paths include properties not modeled in the entity (e.g. calculated properties of an NSManagedObject subclass), since the properties they read are unknown. Default: FALSE.
+ 
+ @note Only enable this when the displayed attributes are a small subset of the entity's attributes, as every other attribute accessed later costs one extra round trip per object.
+ */
+@property (nonatomic, readwrite) BOOL fetchesDisplayedPropertiesOnly;
+
 
 @end
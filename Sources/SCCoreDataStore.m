@@ -13,13 +13,36 @@
 #import "SCCoreDataFetchOptions.h"
 
 
+static NSString * const SCCoreDataStoreImportContextName = @"SCCoreDataStoreImportContext";
+
+
 @interface SCCoreDataStore ()
+{
+    // context changes collected until the next run loop turn
+    NSMutableSet *_pendingInsertedObjects;
+    NSMutableSet *_pendingChangedObjects;
+    NSMutableSet *_pendingDeletedObjects;
+    BOOL _pendingInvalidatedAllObjects;
+    BOOL _objectChangesScheduled;
+}
 
 @property (nonatomic, strong, readwrite) NSMutableSet *boundSet;
 @property (nonatomic, strong, readwrite) NSMutableOrderedSet *boundOrderedSet;
 @property (nonatomic, readwrite) BOOL boundSetOwnsStoreObjects;
 
-- (void)willSaveContext;
+- (void)willSaveContext:(NSNotification *)notification;
+- (void)managedObjectContextObjectsDidChange:(NSNotification *)notification;
+- (void)postPendingObjectChanges;
+- (BOOL)isTrackedObject:(NSManagedObject *)object;
+
+- (NSInteger)nextOrderValueForEntityDefinition:(SCEntityDefinition *)entityDefinition;
+- (NSArray *)batchInsertDictionaries:(NSArray *)dictionaries withEntityDefinition:(SCEntityDefinition *)entityDefinition orderAttributeName:(NSString *)orderAttributeName firstOrder:(NSInteger)firstOrder;
+- (NSArray *)importDictionariesInPrivateContext:(NSArray *)dictionaries withEntityDefinition:(SCEntityDefinition *)entityDefinition orderAttributeName:(NSString *)orderAttributeName firstOrder:(NSInteger)firstOrder;
+- (NSArray *)insertedObjectsForMergedObjectIDs:(NSArray *)objectIDs;
+
+- (NSFetchRequest *)boundRelationshipFetchRequest;
+- (NSArray *)fetchBoundRelationshipObjectsWithRequest:(NSFetchRequest *)fetchRequest filterPredicate:(NSPredicate *)filterPredicate sortDescriptors:(NSArray *)sortDescriptors fetchOptions:(SCCoreDataFetchOptions *)fetchOptions;
+- (void)configureDisplayedPropertiesForFetchRequest:(NSFetchRequest *)fetchRequest fetchOptions:(SCCoreDataFetchOptions *)fetchOptions;
 
 @end
 
@@ -46,9 +69,19 @@
         _boundSet = nil;
         _boundOrderedSet = nil;
         _boundSetOwnsStoreObjects = FALSE;
+        _tracksContextChanges = TRUE;
+        _usesBatchInsertRequests = FALSE;
+        _prefetchesDisplayedRelationships = TRUE;
+        _fetchesDisplayedPropertiesOnly = FALSE;
+        
+        _pendingInsertedObjects = [NSMutableSet set];
+        _pendingChangedObjects = [NSMutableSet set];
+        _pendingDeletedObjects = [NSMutableSet set];
+        _pendingInvalidatedAllObjects = FALSE;
+        _objectChangesScheduled = FALSE;
         
         // Register with managed object notifications
-        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(willSaveContext) name:NSManagedObjectContextWillSaveNotification object:nil];
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(willSaveContext:) name:NSManagedObjectContextWillSaveNotification object:nil];
 	}
 	return self;
 }
@@ -79,12 +112,149 @@
     [[NSNotificationCenter defaultCenter] removeObserver:self];
 }
 
-- (void)willSaveContext
+- (void)setManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
 {
+    if(_managedObjectContext)
+        [[NSNotificationCenter defaultCenter] removeObserver:self name:NSManagedObjectContextObjectsDidChangeNotification object:_managedObjectContext];
+    
+    _managedObjectContext = managedObjectContext;
+    
+    // Changes merged from other contexts (including CloudKit imports) are also reported through this notification
+    if(_managedObjectContext)
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(managedObjectContextObjectsDidChange:) name:NSManagedObjectContextObjectsDidChangeNotification object:_managedObjectContext];
+}
+
+- (void)willSaveContext:(NSNotification *)notification
+{
+    // importObjects: saves its own private context, which never contains the framework's unadded objects
+    NSManagedObjectContext *context = notification.object;
+    if([context isKindOfClass:[NSManagedObjectContext class]] && [context.name isEqualToString:SCCoreDataStoreImportContextName])
+        return;
+    
     // Make sure all invalid unadded objects are removed otherwise Core Data will throw an exception
     [self forceDiscardAllUnaddedObjects];
 }
 
+- (BOOL)isTrackedObject:(NSManagedObject *)object
+{
+    if(![object isKindOfClass:[NSManagedObject class]])
+        return FALSE;
+    
+    // objects still being created by the framework are reported by the sections themselves
+    if([_uninsertedObjects indexOfObjectIdenticalTo:object] != NSNotFound)
+        return FALSE;
+    
+    for(SCDataDefinition *definition in [_dataDefinitions allValues])
+    {
+        if([definition isKindOfClass:[SCEntityDefinition class]] && [object.entity isKindOfEntity:[(SCEntityDefinition *)definition entity]])
+            return TRUE;
+    }
+    
+    return FALSE;
+}
+
+- (void)managedObjectContextObjectsDidChange:(NSNotification *)notification
+{
+    // private queue contexts and merges run through performBlock: post from background threads
+    if(![NSThread isMainThread])
+    {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self managedObjectContextObjectsDidChange:notification];
+        });
+        return;
+    }
+    
+    if(!self.tracksContextChanges)
+        return;
+    
+    NSDictionary *changes = notification.userInfo;
+    
+    if([changes objectForKey:NSInvalidatedAllObjectsKey])
+    {
+        _pendingInvalidatedAllObjects = TRUE;
+    }
+    else
+    {
+        NSMutableSet *deletedObjects = [NSMutableSet set];
+        [deletedObjects unionSet:[changes objectForKey:NSDeletedObjectsKey]];
+        [deletedObjects unionSet:[changes objectForKey:NSInvalidatedObjectsKey]];
+        NSSet *insertedObjects = [changes objectForKey:NSInsertedObjectsKey];
+        
+        // a later notification supersedes what earlier ones in the same run loop turn reported for an object
+        [_pendingInsertedObjects minusSet:deletedObjects];
+        [_pendingChangedObjects minusSet:deletedObjects];
+        [_pendingDeletedObjects unionSet:deletedObjects];
+        if(insertedObjects.count)
+        {
+            [_pendingDeletedObjects minusSet:insertedObjects];
+            [_pendingInsertedObjects unionSet:insertedObjects];
+        }
+        [_pendingChangedObjects unionSet:[changes objectForKey:NSUpdatedObjectsKey]];
+        [_pendingChangedObjects unionSet:[changes objectForKey:NSRefreshedObjectsKey]];
+        [_pendingChangedObjects minusSet:_pendingDeletedObjects];
+    }
+    
+    // saves, merges and imports often post several notifications in a row, apply them all at once
+    if(!_objectChangesScheduled)
+    {
+        _objectChangesScheduled = TRUE;
+        [self performSelector:@selector(postPendingObjectChanges) withObject:nil afterDelay:0];
+    }
+}
+
+- (void)postPendingObjectChanges
+{
+    _objectChangesScheduled = FALSE;
+    
+    NSSet *insertedObjects = [_pendingInsertedObjects copy];
+    NSMutableSet *changedObjects = [_pendingChangedObjects mutableCopy];
+    [changedObjects unionSet:insertedObjects];
+    NSSet *deletedObjects = [_pendingDeletedObjects copy];
+    BOOL invalidatedAllObjects = _pendingInvalidatedAllObjects;
+    [_pendingInsertedObjects removeAllObjects];
+    [_pendingChangedObjects removeAllObjects];
+    [_pendingDeletedObjects removeAllObjects];
+    _pendingInvalidatedAllObjects = FALSE;
+    
+    // A change to the bound object can rearrange its relationship in ways that are not visible from the member objects (e.g. ordered set moves)
+    if(invalidatedAllObjects || (_boundObject && ([changedObjects containsObject:_boundObject] || [deletedObjects containsObject:_boundObject])))
+    {
+        [[NSNotificationCenter defaultCenter] postNotificationName:SCDataStoreDidChangeObjectsNotification object:self userInfo:[NSDictionary dictionaryWithObject:[NSNumber numberWithBool:YES] forKey:SCDataStoreInvalidatedAllObjectsKey]];
+        return;
+    }
+    
+    NSMutableArray *inserted = [NSMutableArray array];
+    NSMutableArray *updated = [NSMutableArray array];
+    NSMutableArray *deleted = [NSMutableArray array];
+    
+    for(NSManagedObject *object in deletedObjects)
+    {
+        if([self isTrackedObject:object])
+            [deleted addObject:object];
+    }
+    for(NSManagedObject *object in changedObjects)
+    {
+        if(![self isTrackedObject:object])
+            continue;
+        
+        // objects that left the bound relationship are no longer part of the store
+        if(self.boundSet && ![self.boundSet containsObject:object])
+            [deleted addObject:object];
+        else if(self.boundOrderedSet && ![self.boundOrderedSet containsObject:object])
+            [deleted addObject:object];
+        else if([insertedObjects containsObject:object])
+            [inserted addObject:object];
+        else
+            [updated addObject:object];
+    }
+    
+    if(!inserted.count && !updated.count && !deleted.count)
+        return;
+    
+    NSDictionary *userInfo = [NSDictionary dictionaryWithObjectsAndKeys:inserted, SCDataStoreInsertedObjectsKey, updated, SCDataStoreUpdatedObjectsKey, deleted, SCDataStoreDeletedObjectsKey, nil];
+    [[NSNotificationCenter defaultCenter] postNotificationName:SCDataStoreDidChangeObjectsNotification object:self userInfo:userInfo];
+}
+
 // overrides superclass
 - (NSObject *)createNewObjectWithDefinition:(SCDataDefinition *)definition
 {
@@ -315,7 +485,19 @@
         sortDescriptors = [coreDataFetchOptions sortDescriptors];
     
     NSMutableArray *array = [NSMutableArray array];
+    NSFetchRequest *boundRelationshipFetchRequest = nil;
     if(self.boundSet || self.boundOrderedSet)
+        boundRelationshipFetchRequest = [self boundRelationshipFetchRequest];
+    
+    if(boundRelationshipFetchRequest)
+    {
+        // let the persistent store filter, sort and batch the relationship's objects
+        [array addObjectsFromArray:[self fetchBoundRelationshipObjectsWithRequest:boundRelationshipFetchRequest filterPredicate:filterPredicate sortDescriptors:sortDescriptors fetchOptions:coreDataFetchOptions]];
+        
+        if(coreDataFetchOptions.batchSize)
+            [coreDataFetchOptions incrementBatchOffset];
+    }
+    else if(self.boundSet || self.boundOrderedSet)
     {
         if(self.boundSet)
             [array addObjectsFromArray:[self.boundSet allObjects]];
@@ -365,6 +547,7 @@
                 continue;
             
             [fetchRequest setEntity:entityDefinition.entity];
+            [self configureDisplayedPropertiesForFetchRequest:fetchRequest fetchOptions:coreDataFetchOptions];
             [array addObjectsFromArray:[entityDefinition.managedObjectContext executeFetchRequest:fetchRequest error:NULL]];
         }
 		
@@ -375,6 +558,261 @@
     return array;
 }
 
+// overrides superclass
+- (NSUInteger)countObjectsWithOptions:(SCDataFetchOptions *)fetchOptions
+{
+    // plain fetch options are always filtered, just like in fetchObjectsWithOptions:
+    NSPredicate *filterPredicate = nil;
+    if(fetchOptions.filter || ![fetchOptions isKindOfClass:[SCCoreDataFetchOptions class]])
+        filterPredicate = fetchOptions.filterPredicate;
+    
+    NSFetchRequest *boundRelationshipFetchRequest = nil;
+    if(self.boundSet || self.boundOrderedSet)
+        boundRelationshipFetchRequest = [self boundRelationshipFetchRequest];
+    
+    NSUInteger count = 0;
+    if(boundRelationshipFetchRequest)
+    {
+        if(filterPredicate)
+            [boundRelationshipFetchRequest setPredicate:[NSCompoundPredicate andPredicateWithSubpredicates:@[boundRelationshipFetchRequest.predicate, filterPredicate]]];
+        
+        NSManagedObjectContext *context = [(NSManagedObject *)_boundObject managedObjectContext];
+        @try
+        {
+            count = [context countForFetchRequest:boundRelationshipFetchRequest error:NULL];
+        }
+        @catch (NSException *e)
+        {
+            SCDebugLog(@"Warning: Invalid filter predicate: %@.", filterPredicate);
+            count = NSNotFound;
+        }
+    }
+    else if(self.boundSet || self.boundOrderedSet)
+    {
+        if(!filterPredicate)
+            return self.boundSet ? self.boundSet.count : self.boundOrderedSet.count;
+        
+        id<NSFastEnumeration> objects = self.boundSet ? (id<NSFastEnumeration>)self.boundSet : (id<NSFastEnumeration>)self.boundOrderedSet;
+        @try
+        {
+            for(NSObject *object in objects)
+            {
+                if([filterPredicate evaluateWithObject:object])
+                    count++;
+            }
+        }
+        @catch (NSException *e)
+        {
+            SCDebugLog(@"Warning: Invalid filter predicate: %@.", filterPredicate);
+            count = NSNotFound;
+        }
+    }
+    else
+    {
+        NSFetchRequest *fetchRequest = [[NSFetchRequest alloc] init];
+        if(filterPredicate)
+            [fetchRequest setPredicate:filterPredicate];
+        
+        // count all entities in dataDefinitions
+        for(SCEntityDefinition *entityDefinition in [_dataDefinitions allValues])
+        {
+            if(![entityDefinition isKindOfClass:[SCEntityDefinition class]])
+                continue;
+            
+            [fetchRequest setEntity:entityDefinition.entity];
+            NSUInteger entityCount = NSNotFound;
+            @try
+            {
+                entityCount = [entityDefinition.managedObjectContext countForFetchRequest:fetchRequest error:NULL];
+            }
+            @catch (NSException *e)
+            {
+                SCDebugLog(@"Warning: Invalid filter predicate: %@.", filterPredicate);
+            }
+            if(entityCount == NSNotFound)
+                return NSNotFound;
+            count += entityCount;
+        }
+    }
+    
+    return count;
+}
+
+- (NSFetchRequest *)boundRelationshipFetchRequest
+{
+    if(![_boundObject isKindOfClass:[NSManagedObject class]] || [_boundPropertyName rangeOfString:@"."].location!=NSNotFound)
+        return nil;
+    
+    NSManagedObject *ownerObject = (NSManagedObject *)_boundObject;
+    
+    // unsaved changes to the relationship can only be evaluated in memory
+    if(ownerObject.isInserted || (ownerObject.hasChanges && [[ownerObject changedValues] objectForKey:_boundPropertyName]))
+        return nil;
+    
+    NSRelationshipDescription *relationship = [[ownerObject.entity relationshipsByName] objectForKey:_boundPropertyName];
+    NSRelationshipDescription *inverseRelationship = relationship.inverseRelationship;
+    if(!inverseRelationship)
+        return nil;
+    
+    NSPredicate *relationshipPredicate;
+    if(inverseRelationship.isToMany)
+        relationshipPredicate = [NSPredicate predicateWithFormat:@"ANY %K == %@", inverseRelationship.name, ownerObject];
+    else
+        relationshipPredicate = [NSPredicate predicateWithFormat:@"%K == %@", inverseRelationship.name, ownerObject];
+    
+    NSFetchRequest *fetchRequest = [[NSFetchRequest alloc] init];
+    [fetchRequest setEntity:relationship.destinationEntity];
+    [fetchRequest setPredicate:relationshipPredicate];
+    
+    return fetchRequest;
+}
+
+- (NSArray *)fetchBoundRelationshipObjectsWithRequest:(NSFetchRequest *)fetchRequest filterPredicate:(NSPredicate *)filterPredicate sortDescriptors:(NSArray *)sortDescriptors fetchOptions:(SCCoreDataFetchOptions *)fetchOptions
+{
+    NSManagedObjectContext *context = [(NSManagedObject *)_boundObject managedObjectContext];
+    NSRange batchRange = NSMakeRange(0, 0);
+    if(fetchOptions.batchSize)
+        batchRange = NSMakeRange(fetchOptions.batchCurrentOffset*fetchOptions.batchSize, fetchOptions.batchSize);
+    
+    if(filterPredicate)
+        [fetchRequest setPredicate:[NSCompoundPredicate andPredicateWithSubpredicates:@[fetchRequest.predicate, filterPredicate]]];
+    [self configureDisplayedPropertiesForFetchRequest:fetchRequest fetchOptions:fetchOptions];
+    
+    NSArray *objects = nil;
+    if(self.boundOrderedSet)
+    {
+        // ordered relationships keep their order in the relationship itself, which the store can't sort on
+        NSOrderedSet *orderedSet = self.boundOrderedSet;
+        if(filterPredicate)
+        {
+            @try
+            {
+                objects = [context executeFetchRequest:fetchRequest error:NULL];
+            }
+            @catch (NSException *e)
+            {
+                SCDebugLog(@"Warning: Invalid filter predicate: %@.", filterPredicate);
+                objects = nil;
+            }
+            objects = [objects sortedArrayUsingComparator:^NSComparisonResult(id obj1, id obj2)
+                       {
+                           NSUInteger index1 = [orderedSet indexOfObject:obj1];
+                           NSUInteger index2 = [orderedSet indexOfObject:obj2];
+                           if(index1 < index2)
+                               return NSOrderedAscending;
+                           if(index1 > index2)
+                               return NSOrderedDescending;
+                           return NSOrderedSame;
+                       }];
+        }
+        else
+        {
+            objects = [orderedSet array];   // objects remain faults until displayed
+        }
+        
+        if(batchRange.length)
+        {
+            if(batchRange.location >= objects.count)
+                return [NSArray array];
+            batchRange.length = MIN(batchRange.length, objects.count-batchRange.location);
+            objects = [objects subarrayWithRange:batchRange];
+        }
+    }
+    else
+    {
+        if(sortDescriptors)
+            [fetchRequest setSortDescriptors:sortDescriptors];
+        if(batchRange.length)
+        {
+            [fetchRequest setFetchLimit:batchRange.length];
+            [fetchRequest setFetchOffset:batchRange.location];
+        }
+        
+        @try
+        {
+            objects = [context executeFetchRequest:fetchRequest error:NULL];
+        }
+        @catch (NSException *e)
+        {
+            SCDebugLog(@"Warning: Invalid filter predicate: %@ or sort key: %@.", filterPredicate, fetchOptions.sortKey);
+            objects = nil;
+        }
+    }
+    
+    if(!objects)
+        objects = [NSArray array];
+    
+    return objects;
+}
+
+- (void)configureDisplayedPropertiesForFetchRequest:(NSFetchRequest *)fetchRequest fetchOptions:(SCCoreDataFetchOptions *)fetchOptions
+{
+    fetchRequest.relationshipKeyPathsForPrefetching = nil;
+    fetchRequest.propertiesToFetch = nil;
+    
+    if(!self.prefetchesDisplayedRelationships && !self.fetchesDisplayedPropertiesOnly)
+        return;
+    
+    NSEntityDescription *entity = fetchRequest.entity;
+    SCEntityDefinition *entityDefinition = [_dataDefinitions valueForKey:entity.name];
+    if(!entity || ![entityDefinition isKindOfClass:[SCEntityDefinition class]])
+        return;
+    
+    // gather the key paths the rows render and the store sorts by
+    NSMutableSet *keyPaths = [NSMutableSet set];
+    if(entityDefinition.titlePropertyName)
+        [keyPaths addObjectsFromArray:[entityDefinition.titlePropertyName componentsSeparatedByString:@";"]];
+    if(entityDefinition.descriptionPropertyName)
+        [keyPaths addObjectsFromArray:[entityDefinition.descriptionPropertyName componentsSeparatedByString:@";"]];
+    if(entityDefinition.keyPropertyName)
+        [keyPaths addObject:entityDefinition.keyPropertyName];
+    if(entityDefinition.orderAttributeName)
+        [keyPaths addObject:entityDefinition.orderAttributeName];
+    if(fetchOptions.sortKey)
+        [keyPaths addObject:fetchOptions.sortKey];
+    if(fetchOptions.relationshipKeyPathsForPrefetching)
+        [keyPaths addObjectsFromArray:fetchOptions.relationshipKeyPathsForPrefetching];
+    
+    NSMutableSet *prefetchKeyPaths = [NSMutableSet set];
+    NSMutableSet *propertiesToFetch = [NSMutableSet set];
+    BOOL canFetchPartially = self.fetchesDisplayedPropertiesOnly;
+    for(NSString *keyPath in keyPaths)
+    {
+        if(!keyPath.length)
+            continue;
+        
+        NSArray *keys = [keyPath componentsSeparatedByString:@"."];
+        NSEntityDescription *keyEntity = entity;
+        for(NSUInteger i=0; i<keys.count && keyEntity; i++)
+        {
+            NSPropertyDescription *property = [[keyEntity propertiesByName] objectForKey:[keys objectAtIndex:i]];
+            if(i == 0)
+            {
+                // unmodeled or transient properties may read any attribute of the object
+                if(!property || property.isTransient)
+                    canFetchPartially = FALSE;
+                else if(!([property isKindOfClass:[NSRelationshipDescription class]] && [(NSRelationshipDescription *)property isToMany]))
+                    [propertiesToFetch addObject:property];
+            }
+            
+            if([property isKindOfClass:[NSRelationshipDescription class]])
+            {
+                [prefetchKeyPaths addObject:[[keys subarrayWithRange:NSMakeRange(0, i+1)] componentsJoinedByString:@"."]];
+                keyEntity = [(NSRelationshipDescription *)property destinationEntity];
+            }
+            else
+            {
+                keyEntity = nil;
+            }
+        }
+    }
+    
+    if(self.prefetchesDisplayedRelationships && prefetchKeyPaths.count)
+        fetchRequest.relationshipKeyPathsForPrefetching = [prefetchKeyPaths allObjects];
+    if(canFetchPartially && propertiesToFetch.count)
+        fetchRequest.propertiesToFetch = [propertiesToFetch allObjects];
+}
+
 // overrides superclass
 - (NSObject *)valueForPropertyName:(NSString *)propertyName inObject:(NSObject *)object
 {
@@ -545,6 +983,285 @@
     }
 }
 
+// overrides superclass
+- (void)prefetchObjects:(NSArray *)objects
+{
+    // fire all faults with a single fetch per entity instead of one round trip per object
+    NSMutableDictionary *faultsByEntity = [NSMutableDictionary dictionary];
+    for(NSManagedObject *object in objects)
+    {
+        if(![object isKindOfClass:[NSManagedObject class]] || !object.isFault || object.objectID.isTemporaryID || object.managedObjectContext!=self.managedObjectContext)
+            continue;
+        
+        NSMutableArray *entityFaults = [faultsByEntity objectForKey:object.entity.name];
+        if(!entityFaults)
+        {
+            entityFaults = [NSMutableArray array];
+            [faultsByEntity setObject:entityFaults forKey:object.entity.name];
+        }
+        [entityFaults addObject:object];
+    }
+    
+    for(NSString *entityName in faultsByEntity)
+    {
+        NSFetchRequest *fetchRequest = [NSFetchRequest fetchRequestWithEntityName:entityName];
+        fetchRequest.predicate = [NSPredicate predicateWithFormat:@"SELF IN %@", [faultsByEntity objectForKey:entityName]];
+        fetchRequest.returnsObjectsAsFaults = NO;
+        fetchRequest.includesSubentities = NO;
+        fetchRequest.entity = [(NSManagedObject *)[[faultsByEntity objectForKey:entityName] firstObject] entity];
+        [self configureDisplayedPropertiesForFetchRequest:fetchRequest fetchOptions:nil];
+        
+        [self.managedObjectContext executeFetchRequest:fetchRequest error:NULL];
+    }
+}
+
+// overrides superclass
+- (NSArray *)importObjects:(NSArray *)objects
+{
+    if(![self.defaultDataDefinition isKindOfClass:[SCEntityDefinition class]] || !self.managedObjectContext)
+        return [NSArray array];
+    
+    SCEntityDefinition *entityDefinition = (SCEntityDefinition *)self.defaultDataDefinition;
+    NSManagedObjectContext *context = self.managedObjectContext;
+    
+    // imported objects are reported once in didImportObjects:
+    BOOL tracksContextChanges = self.tracksContextChanges;
+    self.tracksContextChanges = FALSE;
+    
+    // assign order values in a single pass starting after the current last object
+    NSString *orderAttributeName = nil;
+    NSInteger order = 0;
+    if(entityDefinition.orderAttributeName && [entityDefinition isValidPropertyName:entityDefinition.orderAttributeName])
+    {
+        orderAttributeName = entityDefinition.orderAttributeName;
+        order = [self nextOrderValueForEntityDefinition:entityDefinition];
+    }
+    
+    NSArray *importedObjects = nil;
+    if(self.usesBatchInsertRequests)
+        importedObjects = [self batchInsertDictionaries:objects withEntityDefinition:entityDefinition orderAttributeName:orderAttributeName firstOrder:order];
+    if(!importedObjects)
+        importedObjects = [self importDictionariesInPrivateContext:objects withEntityDefinition:entityDefinition orderAttributeName:orderAttributeName firstOrder:order];
+    
+    if(!importedObjects)
+    {
+        // Objects added to a relationship or already managed are imported into the store's own context and left unsaved like objects added with insertObject:, so that unrelated edits in the context aren't saved with them
+        NSMutableArray *mutableImportedObjects = [NSMutableArray arrayWithCapacity:objects.count];
+        NSUInteger batchSize = self.importBatchSize ? self.importBatchSize : objects.count;
+        
+        for(NSUInteger batchStart=0; batchStart<objects.count; batchStart+=batchSize)
+        {
+            @autoreleasepool
+            {
+                NSUInteger batchEnd = MIN(batchStart+batchSize, objects.count);
+                NSMutableArray *batchObjects = [NSMutableArray arrayWithCapacity:batchEnd-batchStart];
+                for(NSUInteger i=batchStart; i<batchEnd; i++)
+                {
+                    NSObject *object = [objects objectAtIndex:i];
+                    if([object isKindOfClass:[NSDictionary class]])
+                    {
+                        NSDictionary *values = (NSDictionary *)object;
+                        NSManagedObject *managedObject = [NSEntityDescription insertNewObjectForEntityForName:entityDefinition.entity.name inManagedObjectContext:context];
+                        [self setImportValues:values inObject:managedObject];
+                        if(orderAttributeName && ![values objectForKey:orderAttributeName])
+                            [managedObject setValue:[NSNumber numberWithInteger:order++] forKey:orderAttributeName];
+                        
+                        [batchObjects addObject:managedObject];
+                    }
+                    else if([object isKindOfClass:[NSManagedObject class]])
+                    {
+                        NSManagedObject *managedObject = (NSManagedObject *)object;
+                        if(!managedObject.managedObjectContext)
+                            [context insertObject:managedObject];
+                        if(_uninsertedObjects.count)
+                            [_uninsertedObjects removeObjectIdenticalTo:managedObject];
+                        
+                        [batchObjects addObject:managedObject];
+                    }
+                }
+                
+                if(self.boundSet)
+                    [self.boundSet addObjectsFromArray:batchObjects];
+                else if(self.boundOrderedSet)
+                    [self.boundOrderedSet addObjectsFromArray:batchObjects];
+                
+                [mutableImportedObjects addObjectsFromArray:batchObjects];
+            }
+        }
+        
+        importedObjects = mutableImportedObjects;
+    }
+    
+    [context processPendingChanges];
+    self.tracksContextChanges = tracksContextChanges;
+    
+    [self didImportObjects:importedObjects];
+    
+    return importedObjects;
+}
+
+- (NSInteger)nextOrderValueForEntityDefinition:(SCEntityDefinition *)entityDefinition
+{
+    NSString *orderAttributeName = entityDefinition.orderAttributeName;
+    NSNumber *maxOrder = nil;
+    
+    if(self.boundSet)
+    {
+        maxOrder = [self.boundSet valueForKeyPath:[NSString stringWithFormat:@"@max.%@", orderAttributeName]];
+    }
+    else if(self.boundOrderedSet)
+    {
+        maxOrder = [self.boundOrderedSet.array valueForKeyPath:[NSString stringWithFormat:@"@max.%@", orderAttributeName]];
+    }
+    else
+    {
+        NSFetchRequest *fetchRequest = [[NSFetchRequest alloc] init];
+        fetchRequest.entity = entityDefinition.entity;
+        fetchRequest.sortDescriptors = [NSArray arrayWithObject:[NSSortDescriptor sortDescriptorWithKey:orderAttributeName ascending:NO]];
+        fetchRequest.fetchLimit = 1;
+        
+        NSManagedObject *lastObject = [[self.managedObjectContext executeFetchRequest:fetchRequest error:NULL] firstObject];
+        maxOrder = [lastObject valueForKey:orderAttributeName];
+    }
+    
+    if(!maxOrder)
+        return 0;
+    //else
+    return [maxOrder integerValue] + 1;
+}
+
+- (NSArray *)batchInsertDictionaries:(NSArray *)dictionaries withEntityDefinition:(SCEntityDefinition *)entityDefinition orderAttributeName:(NSString *)orderAttributeName firstOrder:(NSInteger)firstOrder
+{
+    if (@available(iOS 13.0, *))
+    {
+        // Batch inserts write directly to the store and cannot set relationships
+        if(_boundObject || !dictionaries.count)
+            return nil;
+        NSPersistentStoreCoordinator *coordinator = self.managedObjectContext.persistentStoreCoordinator;
+        if(!coordinator.persistentStores.count)
+            return nil;
+        for(NSPersistentStore *store in coordinator.persistentStores)
+        {
+            if(![store.type isEqualToString:NSSQLiteStoreType])
+                return nil;
+        }
+        
+        NSDictionary *attributes = entityDefinition.entity.attributesByName;
+        NSMutableArray *batchDictionaries = [NSMutableArray arrayWithCapacity:dictionaries.count];
+        NSInteger order = firstOrder;
+        for(NSObject *object in dictionaries)
+        {
+            if(![object isKindOfClass:[NSDictionary class]])
+                return nil;
+            NSDictionary *values = (NSDictionary *)object;
+            for(NSString *key in values)
+            {
+                if(![attributes objectForKey:key])
+                    return nil;
+            }
+            
+            if(orderAttributeName && ![values objectForKey:orderAttributeName])
+            {
+                NSMutableDictionary *orderedValues = [NSMutableDictionary dictionaryWithDictionary:values];
+                [orderedValues setObject:[NSNumber numberWithInteger:order++] forKey:orderAttributeName];
+                values = orderedValues;
+            }
+            [batchDictionaries addObject:values];
+        }
+        
+        NSBatchInsertRequest *batchInsertRequest = [[NSBatchInsertRequest alloc] initWithEntity:entityDefinition.entity objects:batchDictionaries];
+        batchInsertRequest.resultType = NSBatchInsertRequestResultTypeObjectIDs;
+        
+        NSError *error = nil;
+        NSBatchInsertResult *result = (NSBatchInsertResult *)[self.managedObjectContext executeRequest:batchInsertRequest error:&error];
+        if(!result)
+        {
+            SCDebugLog(@"Warning: SCCoreDataStore batch insert failed, inserting objects individually instead. (Error: %@)", error);
+            return nil;
+        }
+        
+        return [self insertedObjectsForMergedObjectIDs:result.result];
+    }
+    
+    return nil;
+}
+
+- (NSArray *)importDictionariesInPrivateContext:(NSArray *)dictionaries withEntityDefinition:(SCEntityDefinition *)entityDefinition orderAttributeName:(NSString *)orderAttributeName firstOrder:(NSInteger)firstOrder
+{
+    // Objects added to a relationship or referencing other managed objects must be created in the store's own context
+    NSPersistentStoreCoordinator *coordinator = self.managedObjectContext.persistentStoreCoordinator;
+    if(_boundObject || !dictionaries.count || !coordinator)
+        return nil;
+    for(NSObject *object in dictionaries)
+    {
+        if(![object isKindOfClass:[NSDictionary class]])
+            return nil;
+        for(NSObject *value in [(NSDictionary *)object objectEnumerator])
+        {
+            if([value isKindOfClass:[NSManagedObject class]])
+                return nil;
+        }
+    }
+    
+    // Saving a private context only writes the imported objects, and resetting it after each batch keeps memory bounded
+    NSManagedObjectContext *importContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+    importContext.persistentStoreCoordinator = coordinator;
+    importContext.undoManager = nil;
+    importContext.name = SCCoreDataStoreImportContextName;
+    
+    NSString *entityName = entityDefinition.entity.name;
+    NSUInteger batchSize = self.importBatchSize ? self.importBatchSize : dictionaries.count;
+    NSMutableArray *objectIDs = [NSMutableArray arrayWithCapacity:dictionaries.count];
+    [importContext performBlockAndWait:^{
+        NSInteger order = firstOrder;
+        for(NSUInteger batchStart=0; batchStart<dictionaries.count; batchStart+=batchSize)
+        {
+            @autoreleasepool
+            {
+                NSUInteger batchEnd = MIN(batchStart+batchSize, dictionaries.count);
+                NSMutableArray *batchObjects = [NSMutableArray arrayWithCapacity:batchEnd-batchStart];
+                for(NSUInteger i=batchStart; i<batchEnd; i++)
+                {
+                    NSDictionary *values = [dictionaries objectAtIndex:i];
+                    NSManagedObject *managedObject = [NSEntityDescription insertNewObjectForEntityForName:entityName inManagedObjectContext:importContext];
+                    [self setImportValues:values inObject:managedObject];
+                    if(orderAttributeName && ![values objectForKey:orderAttributeName])
+                        [managedObject setValue:[NSNumber numberWithInteger:order++] forKey:orderAttributeName];
+                    
+                    [batchObjects addObject:managedObject];
+                }
+                
+                NSError *error = nil;
+                if(![importContext save:&error])
+                {
+                    SCDebugLog(@"Warning: SCCoreDataStore could not save imported objects, stopping the import after %lu objects. (Error: %@)", (unsigned long)objectIDs.count, error);
+                    [importContext reset];
+                    break;
+                }
+                
+                for(NSManagedObject *managedObject in batchObjects)
+                    [objectIDs addObject:managedObject.objectID];
+                [importContext reset];
+            }
+        }
+    }];
+    
+    return [self insertedObjectsForMergedObjectIDs:objectIDs];
+}
+
+- (NSArray *)insertedObjectsForMergedObjectIDs:(NSArray *)objectIDs
+{
+    // bring the context up to date with the store, the objects stay faults until accessed
+    if(objectIDs.count)
+        [NSManagedObjectContext mergeChangesFromRemoteContextSave:[NSDictionary dictionaryWithObject:objectIDs forKey:NSInsertedObjectsKey] intoContexts:[NSArray arrayWithObject:self.managedObjectContext]];
+    
+    NSMutableArray *insertedObjects = [NSMutableArray arrayWithCapacity:objectIDs.count];
+    for(NSManagedObjectID *objectID in objectIDs)
+        [insertedObjects addObject:[self.managedObjectContext objectWithID:objectID]];
+    
+    return insertedObjects;
+}
+
 // overrides superclass
 - (void)commitData
 {
@@ -14,6 +14,15 @@
 
 
 
+@interface SCDataDefinition ()
+{
+    SCDisplayStringFormatter *_titleFormatter;          // compiled from titlePropertyName & titlePropertyNameDelimiter
+    SCDisplayStringFormatter *_descriptionFormatter;    // compiled from descriptionPropertyName
+}
+
+@end
+
+
 
 @implementation SCDataDefinition
 
@@ -283,8 +292,20 @@
 
 - (NSString *)titleValueForObject:(NSObject *)object
 {
-	return [SCUtilities stringValueForPropertyName:self.titlePropertyName inObject:object
-				   separateValuesUsingDelimiter:self.titlePropertyNameDelimiter];
+    NSString *propertyName = self.titlePropertyName;
+    NSString *delimiter = self.titlePropertyNameDelimiter;
+    if([SCUtilities isBasicDataTypeClass:[object class]] || !propertyName)
+        return [SCUtilities stringValueForPropertyName:propertyName inObject:object separateValuesUsingDelimiter:delimiter];
+    
+    // recompile only when the title configuration changes (both properties are copied, so identity comparison suffices)
+    SCDisplayStringFormatter *formatter = _titleFormatter;
+    if(formatter.propertyNamesString!=propertyName || formatter.delimiter!=delimiter)
+    {
+        formatter = [SCDisplayStringFormatter formatterWithPropertyNamesString:propertyName delimiter:delimiter];
+        _titleFormatter = formatter;
+    }
+    
+	return [formatter stringForObject:object];
 }
 
 - (NSObject *)objectWithTitle:(NSString *)title inObjectsArray:(NSArray *)objectsArray
@@ -300,8 +321,18 @@
 
 - (NSString *)descriptionValueForObject:(NSObject *)object
 {
-    return [SCUtilities stringValueForPropertyName:self.descriptionPropertyName inObject:object
-				   separateValuesUsingDelimiter:@" "];
+    NSString *propertyName = self.descriptionPropertyName;
+    if([SCUtilities isBasicDataTypeClass:[object class]] || !propertyName)
+        return [SCUtilities stringValueForPropertyName:propertyName inObject:object separateValuesUsingDelimiter:@" "];
+    
+    SCDisplayStringFormatter *formatter = _descriptionFormatter;
+    if(formatter.propertyNamesString != propertyName)
+    {
+        formatter = [SCDisplayStringFormatter formatterWithPropertyNamesString:propertyName delimiter:@" "];
+        _descriptionFormatter = formatter;
+    }
+    
+    return [formatter stringForObject:object];
 }
 
 - (void)generatePropertiesFromPropertyNamesArray:(NSArray *)propertyNamesArray propertyTitlesArray:(NSArray *)propertyTitlesArray
@@ -119,6 +119,9 @@
 /** Sorts the given array based on the current sorting configuration. */
 - (void)sortMutableArray:(NSMutableArray *)array;
 
+/** Inserts object into the given array, which is expected to already be sorted based on the current sorting configuration, using a binary search for its position. If the objects around that position turn out to be out of order, the whole array is sorted instead. If sorting is disabled, object is appended to the array. Returns the index object was inserted at. */
+- (NSUInteger)insertObject:(NSObject *)object inSortedMutableArray:(NSMutableArray *)array;
+
 /** Filters the given array based on the current filtering configuration. */
 - (void)filterMutableArray:(NSMutableArray *)array;
 
@@ -115,6 +115,58 @@
     }
 }
 
+- (NSUInteger)insertObject:(NSObject *)object inSortedMutableArray:(NSMutableArray *)array
+{
+    if(!(self.sort && self.sortKey))
+    {
+        [array addObject:object];
+        return array.count-1;
+    }
+    
+    NSArray *descriptors = [self sortDescriptors];
+    NSComparator comparator = ^NSComparisonResult(id obj1, id obj2)
+    {
+        for(NSSortDescriptor *descriptor in descriptors)
+        {
+            NSComparisonResult result = [descriptor compareObject:obj1 toObject:obj2];
+            if(result != NSOrderedSame)
+                return result;
+        }
+        return NSOrderedSame;
+    };
+    
+    NSUInteger index = NSNotFound;
+    @try 
+    {
+        // insert after any equal objects, matching where a stable sort would have placed it
+        index = [array indexOfObject:object inSortedRange:NSMakeRange(0, array.count)
+                             options:(NSBinarySearchingInsertionIndex | NSBinarySearchingLastEqual)
+                     usingComparator:comparator];
+        
+        // items modified in place can leave the array out of order, in which case the search result can't be trusted
+        if(index>0 && comparator([array objectAtIndex:index-1], object)==NSOrderedDescending)
+            index = NSNotFound;
+        else
+            if(index<array.count && comparator(object, [array objectAtIndex:index])==NSOrderedDescending)
+                index = NSNotFound;
+    }
+    @catch (NSException * e) 
+    {
+        index = NSNotFound;
+    }
+    
+    if(index == NSNotFound)
+    {
+        // array holds objects that can't be compared or is no longer sorted, fall back to a full sort
+        [array addObject:object];
+        [self sortMutableArray:array];
+        return [array indexOfObjectIdenticalTo:object];
+    }
+    
+    [array insertObject:object atIndex:index];
+    return index;
+}
+
 - (void)filterMutableArray:(NSMutableArray *)array
 {
     if(self.filterPredicate)
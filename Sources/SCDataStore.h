@@ -16,10 +16,18 @@
 
 /* Data store notifications (used internally) */
 extern NSString * const SCDataStoreWillDiscardAllUninsertedObjectsNotification;
+extern NSString * const SCDataStoreDidChangeObjectsNotification;
+
+/* SCDataStoreDidChangeObjectsNotification userInfo keys (used internally) */
+extern NSString * const SCDataStoreInsertedObjectsKey;
+extern NSString * const SCDataStoreUpdatedObjectsKey;
+extern NSString * const SCDataStoreDeletedObjectsKey;
+extern NSString * const SCDataStoreInvalidatedAllObjectsKey;
 
 
 typedef NS_ENUM(NSInteger, SCStoreMode) { SCStoreModeSynchronous, SCStoreModeAsynchronous };
 typedef void(^SCDataStoreFetchSuccess_Block)(NSArray *results);
+typedef void(^SCDataStoreCountSuccess_Block)(NSUInteger count);
 typedef void(^SCDataStoreInsertSuccess_Block)(void);
 typedef void(^SCDataStoreUpdateSuccess_Block)(void);
 typedef void(^SCDataStoreDeleteSuccess_Block)(void);
@@ -90,6 +98,9 @@ typedef void(^SCPostFetchAsyncronousAction_Block)(NSArray *results, SCPostFetchA
 /** Whether the data store supports nil values. Default: YES. */
 @property (nonatomic, readwrite) BOOL supportsNilValues;
 
+/** The number of objects importObjects: inserts per batch, draining its autorelease pool after each one. SCCoreDataStore saves each batch of new objects separately and releases it from memory. Default: 500. */
+@property (nonatomic, readwrite) NSUInteger importBatchSize;
+
 /** Adds a definition to dataDefinitions. */
 - (void)addDataDefinition:(SCDataDefinition *)definition;
 
@@ -162,6 +173,13 @@ typedef void(^SCPostFetchAsyncronousAction_Block)(NSArray *results, SCPostFetchA
  */
 - (NSArray *)fetchObjectsWithOptions:(SCDataFetchOptions *)fetchOptions;
 
+/** Returns the number of objects in the data store that satisfy the given fetch options' filter, ignoring any batching. This is typically much cheaper than fetching the objects, and is used by sections to determine if more batches are available.
+ @param fetchOptions The fetch options that the counted objects must satisfy.
+ @return The number of objects, or NSNotFound if the store can't count its objects without fetching them.
+ @note Default implementation returns NSNotFound. Subclasses should override this method whenever they can count their objects efficiently.
+ */
+- (NSUInteger)countObjectsWithOptions:(SCDataFetchOptions *)fetchOptions;
+
 /** Returns the value for the given property name in the given object. 
  @param propertyName The name of the property.
  @param object The object containing propertyName.
@@ -305,6 +323,24 @@ typedef void(^SCPostFetchAsyncronousAction_Block)(NSArray *results, SCPostFetchA
  */
 - (void)asynchronousFetchObjectsWithOptions:(SCDataFetchOptions *)fetchOptions success:(SCDataStoreFetchSuccess_Block)success_block failure:(SCDataStoreFailure_Block)failure_block noConnection:(SCNoConnection_Block)noConnection_block;
 
+/** Asynchronously counts the objects in the data store that satisfy the given fetch options' filter, ignoring any batching.
+ @param fetchOptions The fetch options that the counted objects must satisfy.
+ @param success_block The code block called after the objects have been successfully counted.
+ 
+ SCDataStoreCountSuccess_Block syntax:
+    ^(NSUInteger count)
+    {
+        // Your code here
+    }
+ Where 'count' is the number of objects, or NSNotFound if the store can't count its objects without fetching them.
+ @param failure_block The code block called in case the objects could not be counted.
+ @param noConnection_block The code block called in case no connection could be established to data store.
+ 
+ @note Implementing this method is optional. Default implementation calls success_block with NSNotFound, in which case sections determine if more batches are available from the size of the last fetched batch.
+ @see countObjectsWithOptions:
+ */
+- (void)asynchronousCountObjectsWithOptions:(SCDataFetchOptions *)fetchOptions success:(SCDataStoreCountSuccess_Block)success_block failure:(SCDataStoreFailure_Block)failure_block noConnection:(SCNoConnection_Block)noConnection_block;
+
 /** Action gets called right after asynchronousFetchObjectsWithOptions has successfully finished.
  
  This action is typically used to asynchronously load further objects or data in addition to the ones fetched in asynchronousFetchObjectsWithOptions.
@@ -361,6 +397,16 @@ typedef void(^SCPostFetchAsyncronousAction_Block)(NSArray *results, SCPostFetchA
 /** Commits the data store objects to the persistent store. This method is only applicable to data stores that store their objects in memory before persisting them to a permenant persistant storage. */
 - (void)commitData;
 
+/** Imports the given objects into the data store in bulk.
+ 
+ Each element in objects can either be an NSDictionary of property values, in which case a new object is created using the store's default data definition and populated with these values, or an object that is already compatible with the store. Objects are inserted in batches of importBatchSize, and all sections using the store are refreshed once when the import is complete.
+ 
+ @param objects The objects to be imported.
+ @return An array of the objects that were inserted into the store.
+ @note This method is much faster than calling createNewObject and insertObject: for each object, and should be used whenever a large number of objects need to be added to the store.
+ */
+- (NSArray *)importObjects:(NSArray *)objects;
+
 
 //////////////////////////////////////////////////////////////////////////////////////////
 /// @name Internal Properties & Methods (should only be used by the framework or when subclassing)
@@ -383,6 +429,15 @@ typedef void(^SCPostFetchAsyncronousAction_Block)(NSArray *results, SCPostFetchA
 /** Method called when the application is about to leave the background state. Subclasses should override this method when any initialization is needed at this point. */
 - (void)applicationWillEnterForeground;
 
+/** Sets the given dictionary of property values in an object being imported by importObjects:. Method called internally. */
+- (void)setImportValues:(NSDictionary *)values inObject:(NSObject *)object;
+
+/** Informs all classes using the store that importObjects: has finished, so that they refresh their objects once. Method called internally. */
+- (void)didImportObjects:(NSArray *)objects;
+
+/** Method called internally by sections when the rows displaying the given objects are about to be displayed, so that the store can load the objects' data ahead of time (e.g. fire Core Data faults in a single batch). Default implementation does nothing. */
+- (void)prefetchObjects:(NSArray *)objects;
+
 // Internally checks if the 'postAsynchronousFetchObjectsAction' property has been set before calling success_block
 - (void)fetchObjectsSuccessful:(NSArray *)objects successBlock:(SCDataStoreFetchSuccess_Block)success_block failure:(SCDataStoreFailure_Block)failure_block;
 
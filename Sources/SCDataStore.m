@@ -10,6 +10,12 @@
 #import "SCDataStore.h"
 
 NSString * const SCDataStoreWillDiscardAllUninsertedObjectsNotification = @"SCDataStoreWillDiscardAllUninsertedObjectsNotification";
+NSString * const SCDataStoreDidChangeObjectsNotification = @"SCDataStoreDidChangeObjectsNotification";
+
+NSString * const SCDataStoreInsertedObjectsKey = @"SCDataStoreInsertedObjectsKey";
+NSString * const SCDataStoreUpdatedObjectsKey = @"SCDataStoreUpdatedObjectsKey";
+NSString * const SCDataStoreDeletedObjectsKey = @"SCDataStoreDeletedObjectsKey";
+NSString * const SCDataStoreInvalidatedAllObjectsKey = @"SCDataStoreInvalidatedAllObjectsKey";
 
 
 @implementation SCDataStore
@@ -32,6 +38,7 @@ NSString * const SCDataStoreWillDiscardAllUninsertedObjectsNotification = @"SCDa
         _storeMode = SCStoreModeSynchronous;
         
         _supportsNilValues = YES;
+        _importBatchSize = 500;
         
         _storedData = nil;
         _defaultDataDefinition = nil;
@@ -126,6 +133,12 @@ NSString * const SCDataStoreWillDiscardAllUninsertedObjectsNotification = @"SCDa
     return nil;
 }
 
+- (NSUInteger)countObjectsWithOptions:(SCDataFetchOptions *)fetchOptions
+{
+    // Should be overridden by subclasses that can count their objects without fetching them.
+    return NSNotFound;
+}
+
 - (NSObject *)valueForPropertyName:(NSString *)propertyName inObject:(NSObject *)object
 {
     if([SCUtilities isBasicDataTypeClass:[object class]])
@@ -139,21 +152,17 @@ NSString * const SCDataStoreWillDiscardAllUninsertedObjectsNotification = @"SCDa
 	for(NSString *pName in propertyNames)
 	{
 		NSObject *value = nil;
-		@try 
-		{
-            if([object isKindOfClass:[NSUbiquitousKeyValueStore class]])
-            {
-                value = [(NSUbiquitousKeyValueStore *)object objectForKey:pName];
-            }
-            else
-            {
-                value = [object valueForSensibleKeyPath:pName];
-            }
-		}
-		@catch (NSException * e) 
-		{
-			SCDebugLog(@"Warning: Property '%@' does not exist in object '%@'.", propertyName, NSStringFromClass([object class]));
-		}
+        if([object isKindOfClass:[NSUbiquitousKeyValueStore class]])
+        {
+            value = [(NSUbiquitousKeyValueStore *)object objectForKey:pName];
+        }
+        else
+        {
+            NSObject *ownerObject = nil;
+            NSString *key = nil;
+            if([SCUtilities resolvePropertyName:pName inObject:object ownerObject:&ownerObject key:&key resolution:nil])
+                value = [ownerObject valueForSensibleKeyPath:key];
+        }
 		if(!value)
 			value = [NSNull null];
 		[valuesArray addObject:value];
@@ -181,7 +190,7 @@ NSString * const SCDataStoreWillDiscardAllUninsertedObjectsNotification = @"SCDa
 separateValuesUsingDelimiter:(NSString *)delimiter
 {
     if([SCUtilities isBasicDataTypeClass:[object class]])
-        return [NSString stringWithFormat:@"%@", object];
+        return [object description];
     
     NSObject *value = [self valueForPropertyName:propertyName inObject:object];
 	
@@ -189,25 +198,7 @@ separateValuesUsingDelimiter:(NSString *)delimiter
 		return nil;
 	
 	NSMutableString *stringValue = [NSMutableString string];
-	if([value isKindOfClass:[NSArray class]])
-	{
-		NSArray *stringsArray = (NSArray *)value;
-		for(NSUInteger i=0; i<stringsArray.count; i++)
-		{
-			NSObject *str = [stringsArray objectAtIndex:i];
-			if(![str isKindOfClass:[NSNull class]])
-			{
-				if(i!=0 && delimiter)
-					[stringValue appendString:delimiter];
-				[stringValue appendString:[NSString stringWithFormat:@"%@", str]];
-			}
-		}
-	}
-	else
-	{
-		if(value)
-			[stringValue appendFormat:@"%@", value];
-	}
+	[SCDisplayStringFormatter appendPropertyValue:value toString:stringValue delimiter:delimiter];
 	
 	return stringValue;
 }
@@ -217,30 +208,46 @@ separateValuesUsingDelimiter:(NSString *)delimiter
     if([SCUtilities isBasicDataTypeClass:[object class]])
         return;
     
-    if(![SCUtilities propertyName:propertyName existsInObject:object])
-        return;
-    
     if([object isKindOfClass:[NSUbiquitousKeyValueStore class]])
     {
         [(NSUbiquitousKeyValueStore *)object setObject:value forKey:propertyName];
+        return;
     }
-    else
+    
+    // resolve the property once, then set it directly in its owner object
+    NSObject *ownerObject = nil;
+    NSString *key = nil;
+    SCPropertyResolution resolution = SCPropertyResolutionNone;
+    if(![SCUtilities resolvePropertyName:propertyName inObject:object ownerObject:&ownerObject key:&key resolution:&resolution] || !ownerObject)
+        return;
+    
+    if(!(resolution & SCPropertyResolutionWritable))
     {
-        if(value == nil)
+        SCDebugLog(@"Warning: Property '%@' is not writable in object '%@'.", propertyName, object);
+        return;
+    }
+    
+    if(value == nil)
+    {
+        if(!self.supportsNilValues)
+            value = [NSNull null];
+        
+        // check if the property's data type is scalar since scalars don't support nil
+        BOOL scalar = (resolution & SCPropertyResolutionScalar) != 0;
+        if(!scalar && (resolution & SCPropertyResolutionDynamic))
         {
-            if(!self.supportsNilValues)
-                value = [NSNull null];
-            
-            // check if the property's data type is scalar since scalars don't support nil
+            // runtime resolved properties don't carry type information, fall back to the definition
             SCDataDefinition *dataDef = [self definitionForObject:object];
             SCPropertyDefinition *propertyDef = [dataDef propertyDefinitionWithName:propertyName];
-            if(propertyDef.dataTypeScalar)
-            {
-                value = [NSNumber numberWithUnsignedShort:0];
-            }
+            scalar = propertyDef.dataTypeScalar;
+        }
+        if(scalar)
+        {
+            value = [NSNumber numberWithUnsignedShort:0];
         }
-        [object setValue:value forKeyPath:propertyName];
     }
+    
+    [ownerObject setValue:value forKey:key];
 }
 
 - (BOOL)validateInsertForObject:(NSObject *)object
@@ -332,6 +339,13 @@ separateValuesUsingDelimiter:(NSString *)delimiter
         failure_block(nil);
 }
 
+- (void)asynchronousCountObjectsWithOptions:(SCDataFetchOptions *)fetchOptions success:(SCDataStoreCountSuccess_Block)success_block failure:(SCDataStoreFailure_Block)failure_block noConnection:(SCNoConnection_Block)noConnection_block
+{
+    // Optional for subclasses that support SCDataStoreModeAsynchronous
+    if(success_block)
+        success_block(NSNotFound);
+}
+
 - (void)fetchObjectsSuccessful:(NSArray *)objects successBlock:(SCDataStoreFetchSuccess_Block)success_block failure:(SCDataStoreFailure_Block)failure_block
 {
     if(self.postAsynchronousFetchObjectsAction)
@@ -363,6 +377,67 @@ separateValuesUsingDelimiter:(NSString *)delimiter
     // Does nothing. Should be overridden by subclasses where applicable.
 }
 
+- (NSArray *)importObjects:(NSArray *)objects
+{
+    NSMutableArray *importedObjects = [NSMutableArray arrayWithCapacity:objects.count];
+    NSUInteger batchSize = self.importBatchSize ? self.importBatchSize : objects.count;
+    
+    for(NSUInteger batchStart=0; batchStart<objects.count; batchStart+=batchSize)
+    {
+        @autoreleasepool
+        {
+            NSUInteger batchEnd = MIN(batchStart+batchSize, objects.count);
+            for(NSUInteger i=batchStart; i<batchEnd; i++)
+            {
+                NSObject *object = [objects objectAtIndex:i];
+                if([object isKindOfClass:[NSDictionary class]])
+                {
+                    NSDictionary *values = (NSDictionary *)object;
+                    object = [self createNewObject];
+                    [self setImportValues:values inObject:object];
+                }
+                
+                if(object && [self insertObject:object])
+                    [importedObjects addObject:object];
+            }
+            
+            [self commitData];
+        }
+    }
+    
+    [self didImportObjects:importedObjects];
+    
+    return importedObjects;
+}
+
+- (void)setImportValues:(NSDictionary *)values inObject:(NSObject *)object
+{
+    if(!object)
+        return;
+    
+    for(NSString *propertyName in values)
+    {
+        NSObject *value = [values objectForKey:propertyName];
+        if(value == [NSNull null])
+            value = nil;
+        [self setValue:value forPropertyName:propertyName inObject:object];
+    }
+}
+
+- (void)prefetchObjects:(NSArray *)objects
+{
+    // Does nothing. Should be implemented as needed by subclasses.
+}
+
+- (void)didImportObjects:(NSArray *)objects
+{
+    if(!objects.count)
+        return;
+    
+    // a single refresh is much cheaper than applying each imported object individually
+    [[NSNotificationCenter defaultCenter] postNotificationName:SCDataStoreDidChangeObjectsNotification object:self userInfo:[NSDictionary dictionaryWithObject:[NSNumber numberWithBool:YES] forKey:SCDataStoreInvalidatedAllObjectsKey]];
+}
+
 @end
 
 
@@ -52,6 +52,10 @@
 /** Indicates whether the bar at the bottom of the screen is hidden when the detail view controller is pushed. Default: TRUE. */
 @property (nonatomic, readwrite) BOOL hidesBottomBarWhenPushed;
 
+/** Set to TRUE to have the presenting section keep its automatically generated detail view controllers after they're dismissed, and reuse them (along with their generated cells) the next time an item with the same data definition is presented. This considerably reduces detail view presentation time for large detail views. Default: FALSE.
+ @note: Only applicable to automatically generated detail view controllers of an SCArrayOfItemsSection. Cells are only reused when all the detail view's sections are plain SCObjectSections. Detail views with sections generated for relationship properties are regenerated every time. */
+@property (nonatomic, readwrite) BOOL reuseDetailViewControllers;
+
 @end
 
 
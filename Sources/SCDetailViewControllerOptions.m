@@ -19,6 +19,7 @@
     NSString *_title;
     UITableViewStyle _tableViewStyle;
     BOOL _hidesBottomBarWhenPushed;
+    BOOL _reuseDetailViewControllers;
 }
 
 @end
@@ -34,6 +35,7 @@
 @synthesize title = _title;
 @synthesize tableViewStyle = _tableViewStyle;
 @synthesize hidesBottomBarWhenPushed = _hidesBottomBarWhenPushed;
+@synthesize reuseDetailViewControllers = _reuseDetailViewControllers;
 
 
 - (instancetype)init
@@ -47,6 +49,7 @@
         _title = nil;
         _tableViewStyle = UITableViewStyleGrouped;
         _hidesBottomBarWhenPushed = TRUE;
+        _reuseDetailViewControllers = FALSE;
     }
     return self;
 }
@@ -14,61 +14,89 @@
 
 
 
-@interface SCExpandCollapseAccessoryView : UIView
+@interface SCExpandCollapseAccessoryView : UIImageView
 
 @property (nonatomic, weak) SCExpandCollapseCell *ownerExpandCollapseCell;
 
++ (UIImage *)arrowImage;
+
+- (void)setExpanded:(BOOL)expanded animated:(BOOL)animated;
+
 @end
 
 @implementation SCExpandCollapseAccessoryView
 
 @synthesize ownerExpandCollapseCell = _ownerExpandCollapseCell;
 
++ (UIImage *)arrowImage
+{
+    // The arrow is rendered once per screen scale as a template image and shared by all cells
+    static NSMutableDictionary *_arrowImages = nil;
+    
+    CGFloat scale = [UIScreen mainScreen].scale;
+    NSNumber *scaleKey = [NSNumber numberWithDouble:scale];
+    
+    @synchronized(self)
+    {
+        if(!_arrowImages)
+            _arrowImages = [NSMutableDictionary dictionary];
+        
+        UIImage *arrowImage = [_arrowImages objectForKey:scaleKey];
+        if(!arrowImage)
+        {
+            CGRect bounds = CGRectMake(0.0f, 0.0f, 15.0f, 15.0f);
+            UIGraphicsBeginImageContextWithOptions(bounds.size, NO, scale);
+            CGContextRef context = UIGraphicsGetCurrentContext();
+            
+            // draw the collapsed (pointing down) arrow, the expanded arrow is the same image rotated
+            CGFloat arrowRadius = 4.5f;
+            CGFloat x = CGRectGetMidX(bounds);
+            CGFloat y = CGRectGetMaxY(bounds) - 5.0f;
+            
+            CGContextMoveToPoint(context, x-arrowRadius, y-arrowRadius);
+            CGContextAddLineToPoint(context, x, y);
+            CGContextAddLineToPoint(context, x+arrowRadius, y-arrowRadius);
+            
+            CGContextSetLineWidth(context, 3.0f);
+            CGContextSetLineCap(context, kCGLineCapSquare);
+            CGContextSetLineJoin(context, kCGLineJoinMiter);
+            [[UIColor blackColor] setStroke];
+            CGContextStrokePath(context);
+            
+            arrowImage = [UIGraphicsGetImageFromCurrentImageContext() imageWithRenderingMode:UIImageRenderingModeAlwaysTemplate];
+            UIGraphicsEndImageContext();
+            
+            [_arrowImages setObject:arrowImage forKey:scaleKey];
+        }
+        
+        return arrowImage;
+    }
+}
+
 - (instancetype)init
 {
-    if( (self=[super init]) )
+    if( (self=[super initWithImage:[SCExpandCollapseAccessoryView arrowImage]]) )
     {
         _ownerExpandCollapseCell = nil;
         self.frame = CGRectMake(0.0f, 0.0f, 15.0f, 15.0f);
         self.backgroundColor = [UIColor clearColor];
+        self.tintColor = [UIColor grayColor];
     }
     return self;
 }
 
-- (void)drawRect:(CGRect)rect
+- (void)setExpanded:(BOOL)expanded animated:(BOOL)animated
 {
-    // draw the arrow
-    
-    CGContextRef context = UIGraphicsGetCurrentContext();
-    CGContextSaveGState(context);
+    CGAffineTransform transform = expanded ? CGAffineTransformMakeRotation((CGFloat)M_PI) : CGAffineTransformIdentity;
     
-    CGFloat arrowRadius = 4.5f;
-    CGFloat x = CGRectGetMaxX(self.bounds) - 7.0f;
-    
-    if(self.ownerExpandCollapseCell.ownerSectionExpanded)
+    if(animated)
     {
-        CGFloat y = CGRectGetMinY(self.bounds) + 5.0f;
-        
-        CGContextMoveToPoint(context, x-arrowRadius, y+arrowRadius);
-        CGContextAddLineToPoint(context, x, y);
-        CGContextAddLineToPoint(context, x+arrowRadius, y+arrowRadius);
+        [UIView animateWithDuration:0.2 animations:^{ self.transform = transform; }];
     }
-    else 
+    else
     {
-        CGFloat y = CGRectGetMaxY(self.bounds) - 5.0f;
-        
-        CGContextMoveToPoint(context, x-arrowRadius, y-arrowRadius);
-        CGContextAddLineToPoint(context, x, y);
-        CGContextAddLineToPoint(context, x+arrowRadius, y-arrowRadius);
+        self.transform = transform;
     }
-    
-    CGContextSetLineWidth(context, 3.0f);
-    CGContextSetLineCap(context, kCGLineCapSquare);
-    CGContextSetLineJoin(context, kCGLineJoinMiter);
-    [[UIColor grayColor] setStroke];
-    CGContextStrokePath(context);
-    
-    CGContextRestoreGState(context);
 }
 
 @end
@@ -128,7 +156,8 @@
         self.textLabel.text = self.collapseText;
     else 
         self.textLabel.text = self.expandText;
-    [self.accessoryView setNeedsDisplay];
+    if([self.accessoryView isKindOfClass:[SCExpandCollapseAccessoryView class]])
+        [(SCExpandCollapseAccessoryView *)self.accessoryView setExpanded:expanded animated:(self.window!=nil)];
     
     [self.ownerSection setExpanded:expanded];
 }
@@ -103,6 +103,23 @@ typedef NS_ENUM(NSInteger, SCDataType)
 	SCDataTypeUnknown
 };
 
+/* File formats used when persisting images (see [SCUtilities saveImage:toPath:format:compressionQuality:completion:]). */
+typedef NS_ENUM(NSInteger, SCImageFileFormat)
+{
+    SCImageFileFormatJPEG,
+    SCImageFileFormatPNG
+};
+
+/* Describes how a property key resolves in an object (see [SCUtilities resolvePropertyName:inObject:ownerObject:key:resolution:]). */
+typedef NS_OPTIONS(NSUInteger, SCPropertyResolution)
+{
+    SCPropertyResolutionNone        = 0,
+    SCPropertyResolutionReadable    = 1 << 0,
+    SCPropertyResolutionWritable    = 1 << 1,
+    SCPropertyResolutionScalar      = 1 << 2,   // property type doesn't support nil values
+    SCPropertyResolutionDynamic     = 1 << 3    // resolved by the object at runtime (e.g. dictionaries), scalar type unknown
+};
+
 
 
 
@@ -167,6 +184,27 @@ typedef NS_ENUM(NSInteger, SCDataType)
 
 + (BOOL)isURLValid:(NSString *)urlString;
 
+/** Loads the image at the given URL asynchronously. Images are cached in memory and concurrent requests for the same URL share a single download. The completion block is called on the main thread, and the method must be called from the main thread. */
++ (void)loadImageWithURL:(NSURL *)url completion:(void (^)(UIImage *image))completion;
+
+/** Starts loading the image at the given URL ahead of it being displayed (e.g. when rows are prefetched). */
++ (void)prefetchImageWithURL:(NSURL *)url;
+
+/** Cancels a download started by prefetchImageWithURL: unless other requests are waiting for it. */
++ (void)cancelImagePrefetchWithURL:(NSURL *)url;
+
+/** Encodes image and atomically writes it to imagePath on a background queue, as a background task so that the write completes even if the app is suspended. quality (0-1) only applies to SCImageFileFormatJPEG. Until the write finishes, loading imagePath returns image itself. The completion block is called on the main thread, and the method must be called from the main thread. */
++ (void)saveImage:(UIImage *)image toPath:(NSString *)imagePath format:(SCImageFileFormat)format compressionQuality:(CGFloat)quality completion:(void (^)(BOOL success))completion;
+
+/** Same as saveImage:toPath:format:compressionQuality:completion:, except that the file is named after a hash of the encoded image, so identical images are only stored once in directoryPath. The completion block receives the image file name, or nil if saving failed. */
++ (void)saveImage:(UIImage *)image inDirectory:(NSString *)directoryPath format:(SCImageFileFormat)format compressionQuality:(CGFloat)quality completion:(void (^)(NSString *imageName))completion;
+
+/** Returns the image that saveImage:toPath:format:compressionQuality:completion: is still writing to imagePath, or nil if there is none. Synchronous image loaders should check this before reading the file. Must be called from the main thread. */
++ (UIImage *)pendingImageForPath:(NSString *)imagePath;
+
+/** Asynchronously loads the image file at imagePath, decoding it downsampled so that neither of its sides exceeds maxPixelSize (pass 0 for the full size image). Images are cached in memory. The completion block is called on the main thread, and the method must be called from the main thread. */
++ (void)loadImageFromPath:(NSString *)imagePath maxPixelSize:(CGFloat)maxPixelSize completion:(void (^)(UIImage *image))completion;
+
 + (NSObject *)getFirstNodeInNibWithName:(NSString *)nibName;
 
 + (NSString *)getUserFriendlyTitleFromName:(NSString *)propertyName;
@@ -185,8 +223,21 @@ typedef NS_ENUM(NSInteger, SCDataType)
 
 + (NSString *)dataStructureNameForClass:(Class)aClass;
 
+/** Returns TRUE if propertyName exists in object. Property keys are resolved through a per-class cache and no exceptions are raised for missing keys. */
 + (BOOL)propertyName:(NSString *)propertyName existsInObject:(NSObject *)object;
 
+/** Resolves a single property key path in one traversal.
+ *	@param propertyName The property name, can be given in a key-path format.
+ *	@param object The object to resolve propertyName in.
+ *	@param ownerObject Set to the object owning the last key of the key path, or nil if an intermediate value is nil.
+ *	@param key Set to the last key of the key path.
+ *	@param resolution Set to the resolution of the last key in ownerObject.
+ *	@return Returns FALSE if propertyName does not exist in object. */
++ (BOOL)resolvePropertyName:(NSString *)propertyName inObject:(NSObject *)object ownerObject:(NSObject **)ownerObject key:(NSString **)key resolution:(SCPropertyResolution *)resolution;
+
+/** Returns the cached resolution of key in instances of aClass. Method called internally. */
++ (SCPropertyResolution)resolutionForKey:(NSString *)key inClass:(Class)aClass;
+
 /**  Returns the the value for the given property in the given object.
  *	@param propertyName The name of the property whose value is requested. propertyName can be
  *	given in a key-path format (e.g.: "subObject1.subObject2.subObject3"). More than one property
@@ -222,23 +273,71 @@ typedef NS_ENUM(NSInteger, SCDataType)
 
 
 
+/** This class compiles a property names string (e.g. @"firstName;lastName") into a reusable display string formatter. The string is split only once, and every value is appended straight into a single result buffer.
+ * IMPORTANT: This class is usually only used internally by the framework. */
+@interface SCDisplayStringFormatter : NSObject
+{
+    NSString *propertyNamesString;
+    NSString *delimiter;
+    NSArray *propertyNames;
+    NSUInteger estimatedLength;
+}
+
+/** Allocates and returns an initialized formatter for the given property names string and delimiter. */
++ (instancetype)formatterWithPropertyNamesString:(NSString *)namesString delimiter:(NSString *)valuesDelimiter;
+
+/** Returns an initialized formatter for the given property names string and delimiter. */
+- (instancetype)initWithPropertyNamesString:(NSString *)namesString delimiter:(NSString *)valuesDelimiter;
+
+/** The property names string the formatter was compiled from. */
+@property (nonatomic, readonly) NSString *propertyNamesString;
+
+/** The delimiter placed between the values of multiple properties. */
+@property (nonatomic, readonly) NSString *delimiter;
+
+/** Returns the display string for object. Returns nil if the formatter has a single property that does not exist in object. */
+- (NSString *)stringForObject:(NSObject *)object;
+
+/** Appends the display string of a single value to string. Method called internally. */
++ (void)appendValue:(NSObject *)value toString:(NSMutableString *)string;
+
+/** Appends the display string of a property value (an NSArray if it holds multiple values) to string. Method called internally. */
++ (void)appendPropertyValue:(NSObject *)value toString:(NSMutableString *)string delimiter:(NSString *)valuesDelimiter;
+
+@end
+
+
+
+
 @class SCTableViewModel;
 
 /** This class defines a tabel view model center.
  * IMPORTANT: This class is usually only used internally by the framework. */
 @interface SCModelCenter : NSObject
 {
-	CFMutableSetRef modelsSet;
+	NSMapTable *viewControllerModels;   // view controller -> models whose table views it owns, in registration order (neither is retained)
 }
 
 @property (nonatomic, weak) UIViewController *keyboardIssuer;
 
 + (SCModelCenter *)sharedModelCenter;
 
-- (void)registerModel:(SCTableViewModel *)model;
-- (void)unregisterModel:(SCTableViewModel *)model;
+/** Registers model under viewController. Called internally by the model whenever its table view is set or displays cells under a different view controller. */
+- (void)registerModel:(SCTableViewModel *)model forViewController:(UIViewController *)viewController;
+/** Removes model from viewController's registered models. */
+- (void)unregisterModel:(SCTableViewModel *)model fromViewController:(UIViewController *)viewController;
+
+/** Registers model under its current viewController.
+ @warning This method has been deprecated. Use registerModel:forViewController: instead. */
+- (void)registerModel:(SCTableViewModel *)model __deprecated_msg("Use registerModel:forViewController: instead.");
+/** Removes model from its current viewController's registered models.
+ @warning This method has been deprecated. Use unregisterModel:fromViewController: instead. */
+- (void)unregisterModel:(SCTableViewModel *)model __deprecated_msg("Use unregisterModel:fromViewController: instead.");
 
+/** Returns the first model registered under viewController. */
 - (SCTableViewModel *)modelForViewController:(UIViewController *)viewController;
+/** Returns all the models registered under viewController, in registration order. */
+- (NSArray *)modelsForViewController:(UIViewController *)viewController;
 
 @end
 
@@ -11,6 +11,8 @@
 #import "SCTableViewModel.h"
 
 #import <objc/runtime.h>
+#import <ImageIO/ImageIO.h>
+#import <CommonCrypto/CommonDigest.h>
 #import <unistd.h>
 #import <netdb.h>
 
@@ -270,6 +272,14 @@
 
 
 
+@interface SCUtilities ()
+
++ (SCPropertyResolution)staticResolutionForKey:(NSString *)key inClass:(Class)aClass;
++ (SCPropertyResolution)resolutionForKey:(NSString *)key inObject:(NSObject *)object;
+
+@end
+
+
 @implementation SCUtilities
 
 + (double)systemVersion
@@ -326,6 +336,271 @@
     return valid;
 }
 
+// image loading state, only accessed from the main thread
+static NSCache *_imageCache = nil;                          // URL -> UIImage
+static NSMutableDictionary *_imageLoadCompletions = nil;    // URL -> completion blocks waiting for the download
+static NSMutableDictionary *_imageLoadTasks = nil;          // URL -> NSURLSessionDataTask
+
++ (void)loadImageWithURL:(NSURL *)url completion:(void (^)(UIImage *image))completion
+{
+    if(!url)
+        return;
+    
+    if(!_imageCache)
+    {
+        _imageCache = [[NSCache alloc] init];
+        _imageLoadCompletions = [NSMutableDictionary dictionary];
+        _imageLoadTasks = [NSMutableDictionary dictionary];
+    }
+    
+    UIImage *cachedImage = [_imageCache objectForKey:url];
+    if(cachedImage)
+    {
+        if(completion)
+            completion(cachedImage);
+        return;
+    }
+    
+    NSMutableArray *completions = [_imageLoadCompletions objectForKey:url];
+    if(completions)
+    {
+        // download already in progress
+        if(completion)
+            [completions addObject:[completion copy]];
+        return;
+    }
+    
+    completions = [NSMutableArray array];
+    if(completion)
+        [completions addObject:[completion copy]];
+    [_imageLoadCompletions setObject:completions forKey:url];
+    
+    NSURLSessionDataTask *task = [[NSURLSession sharedSession] dataTaskWithURL:url completionHandler:^(NSData *data, NSURLResponse *response, NSError *error)
+    {
+        UIImage *image = data ? [UIImage imageWithData:data] : nil;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            NSArray *waitingCompletions = [_imageLoadCompletions objectForKey:url];
+            [_imageLoadCompletions removeObjectForKey:url];
+            [_imageLoadTasks removeObjectForKey:url];
+            
+            if(image)
+                [_imageCache setObject:image forKey:url];
+            for(void (^waitingCompletion)(UIImage *) in waitingCompletions)
+                waitingCompletion(image);
+        });
+    }];
+    [_imageLoadTasks setObject:task forKey:url];
+    [task resume];
+}
+
++ (void)prefetchImageWithURL:(NSURL *)url
+{
+    [self loadImageWithURL:url completion:nil];
+}
+
++ (void)cancelImagePrefetchWithURL:(NSURL *)url
+{
+    if(!url || [[_imageLoadCompletions objectForKey:url] count])
+        return;  // someone is waiting for the image
+    
+    NSURLSessionDataTask *task = [_imageLoadTasks objectForKey:url];
+    [task cancel];
+}
+
+// image file state, only accessed from the main thread
+static NSCache *_imageFileCache = nil;                  // path -> (max pixel size -> UIImage)
+static NSMutableDictionary *_pendingImageWrites = nil;  // path -> UIImage still being written
+
++ (dispatch_queue_t)imageFileQueue
+{
+    static dispatch_queue_t _imageFileQueue = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _imageFileQueue = dispatch_queue_create("com.sensiblecocoa.imagefiles", DISPATCH_QUEUE_SERIAL);
+    });
+    
+    return _imageFileQueue;
+}
+
++ (UIBackgroundTaskIdentifier)beginImageFileBackgroundTask
+{
+    // let writes started just before the app is suspended finish
+    __block UIBackgroundTaskIdentifier taskIdentifier = UIBackgroundTaskInvalid;
+    taskIdentifier = [[UIApplication sharedApplication] beginBackgroundTaskWithName:@"com.sensiblecocoa.imagefiles" expirationHandler:^
+                      {
+                          [[UIApplication sharedApplication] endBackgroundTask:taskIdentifier];
+                          taskIdentifier = UIBackgroundTaskInvalid;
+                      }];
+    
+    return taskIdentifier;
+}
+
++ (void)endImageFileBackgroundTask:(UIBackgroundTaskIdentifier)taskIdentifier
+{
+    if(taskIdentifier != UIBackgroundTaskInvalid)
+        [[UIApplication sharedApplication] endBackgroundTask:taskIdentifier];
+}
+
++ (UIImage *)pendingImageForPath:(NSString *)imagePath
+{
+    if(!imagePath)
+        return nil;
+    
+    return [_pendingImageWrites objectForKey:imagePath];
+}
+
++ (NSData *)dataForImage:(UIImage *)image format:(SCImageFileFormat)format compressionQuality:(CGFloat)quality
+{
+    if(format == SCImageFileFormatPNG)
+        return UIImagePNGRepresentation(image);
+    //else
+    return UIImageJPEGRepresentation(image, fmax(0, fmin(quality, 1)));
+}
+
++ (void)saveImage:(UIImage *)image toPath:(NSString *)imagePath format:(SCImageFileFormat)format compressionQuality:(CGFloat)quality completion:(void (^)(BOOL success))completion
+{
+    if(!image || !imagePath)
+    {
+        if(completion)
+            completion(FALSE);
+        return;
+    }
+    
+    if(!_pendingImageWrites)
+        _pendingImageWrites = [NSMutableDictionary dictionary];
+    [_pendingImageWrites setObject:image forKey:imagePath];
+    [_imageFileCache removeObjectForKey:imagePath];
+    
+    UIBackgroundTaskIdentifier taskIdentifier = [self beginImageFileBackgroundTask];
+    dispatch_async([self imageFileQueue], ^{
+        BOOL success;
+        @autoreleasepool
+        {
+            NSData *data = [self dataForImage:image format:format compressionQuality:quality];
+            success = [data writeToFile:imagePath atomically:YES];
+        }
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if([_pendingImageWrites objectForKey:imagePath] == image)
+                [_pendingImageWrites removeObjectForKey:imagePath];
+            if(completion)
+                completion(success);
+            
+            [self endImageFileBackgroundTask:taskIdentifier];
+        });
+    });
+}
+
++ (void)saveImage:(UIImage *)image inDirectory:(NSString *)directoryPath format:(SCImageFileFormat)format compressionQuality:(CGFloat)quality completion:(void (^)(NSString *imageName))completion
+{
+    if(!image || !directoryPath)
+    {
+        if(completion)
+            completion(nil);
+        return;
+    }
+    
+    UIBackgroundTaskIdentifier taskIdentifier = [self beginImageFileBackgroundTask];
+    dispatch_async([self imageFileQueue], ^{
+        NSString *imageName = nil;
+        @autoreleasepool
+        {
+            NSData *data = [self dataForImage:image format:format compressionQuality:quality];
+            if(data)
+            {
+                unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+                CC_SHA256(data.bytes, (CC_LONG)data.length, digest);
+                NSMutableString *hashString = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH*2 + 4];
+                for(NSUInteger i=0; i<CC_SHA256_DIGEST_LENGTH; i++)
+                    [hashString appendFormat:@"%02x", digest[i]];
+                [hashString appendString:(format==SCImageFileFormatPNG ? @".png" : @".jpg")];
+                
+                NSString *imagePath = [directoryPath stringByAppendingPathComponent:hashString];
+                if([[NSFileManager defaultManager] fileExistsAtPath:imagePath] || [data writeToFile:imagePath atomically:YES])
+                    imageName = hashString;
+            }
+        }
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if(completion)
+                completion(imageName);
+            
+            [self endImageFileBackgroundTask:taskIdentifier];
+        });
+    });
+}
+
++ (void)loadImageFromPath:(NSString *)imagePath maxPixelSize:(CGFloat)maxPixelSize completion:(void (^)(UIImage *image))completion
+{
+    if(!imagePath)
+    {
+        if(completion)
+            completion(nil);
+        return;
+    }
+    
+    UIImage *pendingImage = [_pendingImageWrites objectForKey:imagePath];
+    if(pendingImage)
+    {
+        if(completion)
+            completion(pendingImage);
+        return;
+    }
+    
+    if(!_imageFileCache)
+        _imageFileCache = [[NSCache alloc] init];
+    NSNumber *sizeKey = [NSNumber numberWithInteger:(NSInteger)ceil(maxPixelSize)];
+    UIImage *cachedImage = [[_imageFileCache objectForKey:imagePath] objectForKey:sizeKey];
+    if(cachedImage)
+    {
+        if(completion)
+            completion(cachedImage);
+        return;
+    }
+    
+    CGFloat screenScale = [UIScreen mainScreen].scale;
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        UIImage *image = nil;
+        @autoreleasepool
+        {
+            NSDictionary *sourceOptions = @{(__bridge NSString *)kCGImageSourceShouldCache : @NO};
+            CGImageSourceRef imageSource = CGImageSourceCreateWithURL((__bridge CFURLRef)[NSURL fileURLWithPath:imagePath], (__bridge CFDictionaryRef)sourceOptions);
+            if(imageSource)
+            {
+                NSMutableDictionary *thumbnailOptions = [NSMutableDictionary dictionaryWithDictionary:
+                                                         @{(__bridge NSString *)kCGImageSourceCreateThumbnailFromImageAlways : @YES,
+                                                           (__bridge NSString *)kCGImageSourceCreateThumbnailWithTransform : @YES,
+                                                           (__bridge NSString *)kCGImageSourceShouldCacheImmediately : @YES}];
+                if(maxPixelSize > 0)
+                    [thumbnailOptions setObject:[NSNumber numberWithDouble:maxPixelSize] forKey:(__bridge NSString *)kCGImageSourceThumbnailMaxPixelSize];
+                
+                CGImageRef cgImage = CGImageSourceCreateThumbnailAtIndex(imageSource, 0, (__bridge CFDictionaryRef)thumbnailOptions);
+                if(cgImage)
+                {
+                    image = [UIImage imageWithCGImage:cgImage scale:(maxPixelSize > 0 ? screenScale : 1) orientation:UIImageOrientationUp];
+                    CGImageRelease(cgImage);
+                }
+                CFRelease(imageSource);
+            }
+        }
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if(image && ![_pendingImageWrites objectForKey:imagePath])
+            {
+                NSMutableDictionary *sizedImages = [_imageFileCache objectForKey:imagePath];
+                if(!sizedImages)
+                {
+                    sizedImages = [NSMutableDictionary dictionary];
+                    [_imageFileCache setObject:sizedImages forKey:imagePath];
+                }
+                [sizedImages setObject:image forKey:sizeKey];
+            }
+            if(completion)
+                completion(image);
+        });
+    });
+}
+
 + (NSObject *)getFirstNodeInNibWithName:(NSString *)nibName {
     if (!nibName) {
         return nil;
@@ -404,14 +679,18 @@
 	
 	// Leave a space for every capital letter
 	NSCharacterSet *uppercaseSet = [NSCharacterSet uppercaseLetterCharacterSet];
-	for(NSUInteger i=1; i<[propertyName length]; i++)
+	NSUInteger length = [propertyName length];
+	unichar *characters = malloc(sizeof(unichar) * length * 2);
+	NSUInteger count = 0;
+	for(NSUInteger i=1; i<length; i++)
 	{
 		unichar chr = [propertyName characterAtIndex:i];
 		if([uppercaseSet characterIsMember:chr])
-			[UFName appendString:[NSString stringWithFormat:@" %c", chr]];
-		else
-			[UFName appendString:[NSString stringWithFormat:@"%c", chr]];
+			characters[count++] = ' ';
+		characters[count++] = chr;
 	}
+	CFStringAppendCharacters((__bridge CFMutableStringRef)UFName, characters, count);
+	free(characters);
 	
 	return UFName;
 }
@@ -477,33 +756,222 @@
     return NSStringFromClass(aClass);
 }
 
-+ (BOOL)propertyName:(NSString *)propertyName existsInObject:(NSObject *)object
++ (SCPropertyResolution)staticResolutionForKey:(NSString *)key inClass:(Class)aClass
 {
-    if([self isBasicDataTypeClass:[object class]] || [self isDictionaryClass:[object class]])
-        return TRUE;
+    // Follows the key-value coding search patterns for accessors and instance variables
+    if(![key length])
+        return SCPropertyResolutionNone;
     
-    BOOL propertyExists;
+    NSString *capitalizedKey = [[[key substringToIndex:1] uppercaseString] stringByAppendingString:[key substringFromIndex:1]];
     
-	@try 
-    { 
-        if([object isKindOfClass:[NSUbiquitousKeyValueStore class]])
+    SCPropertyResolution resolution = SCPropertyResolutionNone;
+    const char *typeEncoding = NULL;
+    
+    NSArray *getterNames = @[[@"get" stringByAppendingString:capitalizedKey], key, [@"is" stringByAppendingString:capitalizedKey], [@"_get" stringByAppendingString:capitalizedKey], [@"_" stringByAppendingString:key], [@"countOf" stringByAppendingString:capitalizedKey]];
+    for(NSString *getterName in getterNames)
+    {
+        if([aClass instancesRespondToSelector:NSSelectorFromString(getterName)])
         {
-            [(NSUbiquitousKeyValueStore *)object objectForKey:propertyName];
+            resolution |= SCPropertyResolutionReadable;
+            break;
         }
-        else
+    }
+    
+    NSArray *setterNames = @[[NSString stringWithFormat:@"set%@:", capitalizedKey], [NSString stringWithFormat:@"_set%@:", capitalizedKey]];
+    for(NSString *setterName in setterNames)
+    {
+        Method setter = class_getInstanceMethod(aClass, NSSelectorFromString(setterName));
+        if(setter)
+        {
+            resolution |= SCPropertyResolutionWritable;
+            
+            char argumentType[16];
+            method_getArgumentType(setter, 2, argumentType, sizeof(argumentType));
+            if(argumentType[0] && strchr("cislqCISLQfdB", argumentType[0]))
+                resolution |= SCPropertyResolutionScalar;
+            break;
+        }
+    }
+    
+    if([aClass accessInstanceVariablesDirectly])
+    {
+        NSArray *ivarNames = @[[@"_" stringByAppendingString:key], [@"_is" stringByAppendingString:capitalizedKey], key, [@"is" stringByAppendingString:capitalizedKey]];
+        for(NSString *ivarName in ivarNames)
+        {
+            Ivar ivar = class_getInstanceVariable(aClass, [ivarName UTF8String]);
+            if(ivar)
+            {
+                resolution |= SCPropertyResolutionReadable | SCPropertyResolutionWritable;
+                typeEncoding = ivar_getTypeEncoding(ivar);
+                break;
+            }
+        }
+    }
+    
+    objc_property_t property = class_getProperty(aClass, [key UTF8String]);
+    if(property)
+    {
+        const char *attributes = property_getAttributes(property);
+        if(attributes && attributes[0]=='T')
+            typeEncoding = attributes + 1;
+    }
+    if(typeEncoding && typeEncoding[0] && strchr("cislqCISLQfdB", typeEncoding[0]))
+        resolution |= SCPropertyResolutionScalar;
+    
+    return resolution;
+}
+
++ (SCPropertyResolution)resolutionForKey:(NSString *)key inClass:(Class)aClass
+{
+    static NSMutableDictionary *_resolutionCache = nil;  // class -> (key -> resolution)
+    
+    if(!key || !aClass)
+        return SCPropertyResolutionNone;
+    
+    @synchronized(self)
+    {
+        if(!_resolutionCache)
+            _resolutionCache = [NSMutableDictionary dictionary];
+        
+        NSMutableDictionary *classResolutions = [_resolutionCache objectForKey:(id<NSCopying>)aClass];
+        if(!classResolutions)
+        {
+            classResolutions = [NSMutableDictionary dictionary];
+            [_resolutionCache setObject:classResolutions forKey:(id<NSCopying>)aClass];
+        }
+        
+        NSNumber *resolutionNumber = [classResolutions objectForKey:key];
+        if(!resolutionNumber)
+        {
+            SCPropertyResolution resolution;
+            
+            // dictionary keys (including ones such as 'description' or 'count' that match a getter) are always stored through setValue:forKey:
+            if([self isDictionaryClass:aClass] || [aClass isSubclassOfClass:[NSUserDefaults class]])
+                resolution = (SCPropertyResolutionReadable | SCPropertyResolutionWritable | SCPropertyResolutionDynamic);
+            else
+                resolution = [self staticResolutionForKey:key inClass:aClass];
+            
+            // classes that override key-value coding can still resolve keys without accessors at runtime
+            if(!(resolution & SCPropertyResolutionReadable))
+            {
+                IMP defaultValueForKey = [NSObject instanceMethodForSelector:@selector(valueForKey:)];
+                IMP defaultValueForUndefinedKey = [NSObject instanceMethodForSelector:@selector(valueForUndefinedKey:)];
+                if([aClass instanceMethodForSelector:@selector(valueForKey:)] != defaultValueForKey
+                   || [aClass instanceMethodForSelector:@selector(valueForUndefinedKey:)] != defaultValueForUndefinedKey)
+                {
+                    resolution = SCPropertyResolutionDynamic;
+                }
+            }
+            
+            resolutionNumber = [NSNumber numberWithUnsignedInteger:resolution];
+            [classResolutions setObject:resolutionNumber forKey:key];
+        }
+        
+        return [resolutionNumber unsignedIntegerValue];
+    }
+}
+
++ (SCPropertyResolution)resolutionForKey:(NSString *)key inObject:(NSObject *)object
+{
+    // Dictionaries and user defaults store any key, even one matching a getter of the class
+    if([self isDictionaryClass:[object class]] || [object isKindOfClass:[NSUserDefaults class]])
+        return (SCPropertyResolutionReadable | SCPropertyResolutionWritable | SCPropertyResolutionDynamic);
+    
+    SCPropertyResolution resolution = [self resolutionForKey:key inClass:[object class]];
+    if(!(resolution & SCPropertyResolutionDynamic))
+        return resolution;
+    
+    // Runtime resolution for classes overriding key-value coding
+    
+    Class managedObjectClass = NSClassFromString(@"NSManagedObject");
+    if(managedObjectClass && [object isKindOfClass:managedObjectClass])
+    {
+        // managed objects without a custom subclass
+        NSDictionary *entityProperties = [object valueForKeyPath:@"entity.propertiesByName"];
+        if([entityProperties isKindOfClass:[NSDictionary class]])
         {
-            [object valueForSensibleKeyPath:propertyName];
+            if([entityProperties objectForKey:key])
+                return (SCPropertyResolutionReadable | SCPropertyResolutionWritable | SCPropertyResolutionDynamic);
+            //else
+            return SCPropertyResolutionNone;
         }
-        propertyExists = TRUE; 
     }
-	@catch (NSException *exception) 
-    { 
-        propertyExists = FALSE; 
+    
+    BOOL keyExists;
+    @try
+    {
+        [object valueForKey:key];
+        keyExists = TRUE;
+    }
+    @catch (NSException *exception)
+    {
+        keyExists = FALSE;
+    }
+    
+    if(keyExists)
+        return (SCPropertyResolutionReadable | SCPropertyResolutionWritable | SCPropertyResolutionDynamic);
+    //else
+    return SCPropertyResolutionNone;
+}
+
++ (BOOL)resolvePropertyName:(NSString *)propertyName inObject:(NSObject *)object ownerObject:(NSObject **)ownerObject key:(NSString **)key resolution:(SCPropertyResolution *)resolution
+{
+    NSObject *currentObject = object;
+    NSString *currentKey = nil;
+    SCPropertyResolution currentResolution = SCPropertyResolutionNone;
+    
+    NSArray *keys = [propertyName componentsSeparatedByString:@"."];
+    for(NSUInteger i=0; i<keys.count; i++)
+    {
+        if(i > 0)
+        {
+            // traverse to the next object on the key path
+            currentObject = [currentObject valueForSensibleKeyPath:currentKey];
+            if(!currentObject)
+                break;
+        }
+        
+        currentKey = [keys objectAtIndex:i];
+        
+        // array element keys (e.g. 'items[0]') are resolved through the array property
+        NSString *propertyKey = currentKey;
+        NSRange bracketRange = [currentKey rangeOfString:@"["];
+        if(bracketRange.location != NSNotFound)
+            propertyKey = [currentKey substringToIndex:bracketRange.location];
         
-        SCDebugLog(@"Warning: Property '%@' does not exist in object '%@'.", propertyName, object);   
+        currentResolution = [self resolutionForKey:propertyKey inObject:currentObject];
+        if(!(currentResolution & SCPropertyResolutionReadable))
+        {
+            SCDebugLog(@"Warning: Property '%@' does not exist in object '%@'.", propertyName, object);
+            return FALSE;
+        }
+        
+        if(bracketRange.location != NSNotFound)
+            currentResolution &= ~(SCPropertyResolutionWritable | SCPropertyResolutionScalar);   // array elements can't be set through key-value coding
     }
     
-    return propertyExists;
+    if(ownerObject)
+        *ownerObject = currentObject;
+    if(key)
+        *key = currentKey;
+    if(resolution)
+        *resolution = currentResolution;
+    
+    return TRUE;
+}
+
++ (BOOL)propertyName:(NSString *)propertyName existsInObject:(NSObject *)object
+{
+    if([self isBasicDataTypeClass:[object class]] || [self isDictionaryClass:[object class]])
+        return TRUE;
+    
+    if(!propertyName)
+        return FALSE;
+    
+    if([object isKindOfClass:[NSUbiquitousKeyValueStore class]])
+        return TRUE;
+    
+    return [self resolvePropertyName:propertyName inObject:object ownerObject:nil key:nil resolution:nil];
 }
 
 + (NSObject *)valueForPropertyName:(NSString *)propertyName inObject:(NSObject *)object
@@ -519,21 +987,17 @@
 	for(NSString *pName in propertyNames)
 	{
 		NSObject *value = nil;
-		@try 
-		{
-			if([object isKindOfClass:[NSUbiquitousKeyValueStore class]])
-            {
-                value = [(NSUbiquitousKeyValueStore *)object objectForKey:pName];
-            }
-            else
-            {
-                value = [object valueForSensibleKeyPath:pName];
-            }
-		}
-		@catch (NSException * e) 
-		{
-			SCDebugLog(@"Warning: Property '%@' does not exist in object '%@'.", propertyName, NSStringFromClass([object class]));
-		}
+        if([object isKindOfClass:[NSUbiquitousKeyValueStore class]])
+        {
+            value = [(NSUbiquitousKeyValueStore *)object objectForKey:pName];
+        }
+        else
+        {
+            NSObject *ownerObject = nil;
+            NSString *key = nil;
+            if([self resolvePropertyName:pName inObject:object ownerObject:&ownerObject key:&key resolution:nil])
+                value = [ownerObject valueForSensibleKeyPath:key];
+        }
 		if(!value)
 			value = [NSNull null];
 		[valuesArray addObject:value];
@@ -552,35 +1016,13 @@
 			separateValuesUsingDelimiter:(NSString *)delimiter
 {
 	if([self isBasicDataTypeClass:[object class]])
-        return [NSString stringWithFormat:@"%@", object];
+        return [object description];
     
-    NSObject *value = [SCUtilities valueForPropertyName:propertyName inObject:object];
-	
-	if(!value)
-		return nil;
-	
-	NSMutableString *stringValue = [NSMutableString string];
-	if([value isKindOfClass:[NSArray class]])
-	{
-		NSArray *stringsArray = (NSArray *)value;
-		for(NSUInteger i=0; i<stringsArray.count; i++)
-		{
-			NSObject *str = [stringsArray objectAtIndex:i];
-			if(![str isKindOfClass:[NSNull class]])
-			{
-				if(i!=0 && delimiter)
-					[stringValue appendString:delimiter];
-				[stringValue appendString:[NSString stringWithFormat:@"%@", str]];
-			}
-		}
-	}
-	else
-	{
-		if(value)
-			[stringValue appendFormat:@"%@", value];
-	}
-	
-	return stringValue;
+    if(!propertyName)
+        return nil;
+    
+    SCDisplayStringFormatter *formatter = [[SCDisplayStringFormatter alloc] initWithPropertyNamesString:propertyName delimiter:delimiter];
+    return [formatter stringForObject:object];
 }
 
 + (void)setValue:(NSObject *)value forPropertyName:(NSString *)propertyName inObject:(NSObject *)object
@@ -588,32 +1030,29 @@
     if([self isBasicDataTypeClass:[object class]])
         return;
     
-    if(![SCUtilities propertyName:propertyName existsInObject:object])
-        return;
-    
     if([object isKindOfClass:[NSUbiquitousKeyValueStore class]])
     {
         [(NSUbiquitousKeyValueStore *)object setObject:value forKey:propertyName];
+        return;
     }
-    else
+    
+    NSObject *ownerObject = nil;
+    NSString *key = nil;
+    SCPropertyResolution resolution = SCPropertyResolutionNone;
+    if(![self resolvePropertyName:propertyName inObject:object ownerObject:&ownerObject key:&key resolution:&resolution] || !ownerObject)
+        return;
+    
+    if(!(resolution & SCPropertyResolutionWritable))
     {
-        if(value == nil)
-        {
-            // check if the property's data type is scalar since scalars don't support nil
-            objc_property_t property = class_getProperty([object class], [propertyName UTF8String]);
-            if(property)
-            {
-                NSArray *attributesArray = [[NSString stringWithUTF8String: property_getAttributes(property)] 
-                                            componentsSeparatedByString:@","];
-                NSSet *attributesSet = [NSSet setWithArray:attributesArray];
-                if([attributesSet containsObject:@"Tc"] || [attributesSet containsObject:@"Ti"] || [attributesSet containsObject:@"Tf"] || [attributesSet containsObject:@"Td"])
-                {
-                    value = [NSNumber numberWithUnsignedShort:0];
-                }
-            }
-        }
-        [object setValue:value forKeyPath:propertyName];
+        SCDebugLog(@"Warning: Property '%@' is not writable in object '%@'.", propertyName, object);
+        return;
     }
+    
+    // scalars don't support nil
+    if(value == nil && (resolution & SCPropertyResolutionScalar))
+        value = [NSNumber numberWithUnsignedShort:0];
+    
+    [ownerObject setValue:value forKey:key];
 }
 
 + (NSObject *)getValueCompatibleWithDataType:(SCDataType)dataType fromValue:(NSObject *)value
@@ -782,12 +1221,122 @@
 
 
 
+@implementation SCDisplayStringFormatter
+
+@synthesize propertyNamesString;
+@synthesize delimiter;
+
++ (instancetype)formatterWithPropertyNamesString:(NSString *)namesString delimiter:(NSString *)valuesDelimiter
+{
+    return [[[self class] alloc] initWithPropertyNamesString:namesString delimiter:valuesDelimiter];
+}
+
+- (instancetype)initWithPropertyNamesString:(NSString *)namesString delimiter:(NSString *)valuesDelimiter
+{
+    if( (self = [super init]) )
+    {
+        propertyNamesString = [namesString copy];
+        delimiter = [valuesDelimiter copy];
+        propertyNames = [propertyNamesString componentsSeparatedByString:@";"];
+        estimatedLength = 16;
+    }
+    return self;
+}
+
++ (void)appendValue:(NSObject *)value toString:(NSMutableString *)string
+{
+    if([value isKindOfClass:[NSString class]])
+        [string appendString:(NSString *)value];
+    else
+        if([value isKindOfClass:[NSNumber class]])
+            [string appendString:[(NSNumber *)value stringValue]];
+        else
+            if(value)
+                [string appendString:[value description]];  // NSDate and all other objects
+}
+
++ (void)appendPropertyValue:(NSObject *)value toString:(NSMutableString *)string delimiter:(NSString *)valuesDelimiter
+{
+    if(![value isKindOfClass:[NSArray class]])
+    {
+        [self appendValue:value toString:string];
+        return;
+    }
+    
+    // multiple values (or a single array valued property) are displayed delimited, skipping missing values
+    NSArray *valuesArray = (NSArray *)value;
+    for(NSUInteger i=0; i<valuesArray.count; i++)
+    {
+        NSObject *element = [valuesArray objectAtIndex:i];
+        if([element isKindOfClass:[NSNull class]])
+            continue;
+        if(i!=0 && valuesDelimiter)
+            [string appendString:valuesDelimiter];
+        [self appendValue:element toString:string];
+    }
+}
+
+- (NSObject *)valueForPropertyName:(NSString *)propertyName inObject:(NSObject *)object
+{
+    if([object isKindOfClass:[NSUbiquitousKeyValueStore class]])
+        return [(NSUbiquitousKeyValueStore *)object objectForKey:propertyName];
+    
+    NSObject *ownerObject = nil;
+    NSString *key = nil;
+    if([SCUtilities resolvePropertyName:propertyName inObject:object ownerObject:&ownerObject key:&key resolution:nil])
+        return [ownerObject valueForSensibleKeyPath:key];
+    
+    return nil;
+}
+
+- (NSString *)stringForObject:(NSObject *)object
+{
+    if([SCUtilities isBasicDataTypeClass:[object class]])
+        return [object description];
+    
+    NSMutableString *stringValue;
+    if(propertyNames.count == 1)
+    {
+        NSObject *value = [self valueForPropertyName:propertyNamesString inObject:object];
+        if(!value)
+            return nil;
+        if([value isKindOfClass:[NSString class]])
+            return [(NSString *)value copy];
+        
+        stringValue = [NSMutableString stringWithCapacity:estimatedLength];
+        [SCDisplayStringFormatter appendPropertyValue:value toString:stringValue delimiter:delimiter];
+    }
+    else
+    {
+        stringValue = [NSMutableString stringWithCapacity:estimatedLength];
+        for(NSUInteger i=0; i<propertyNames.count; i++)
+        {
+            NSObject *value = [self valueForPropertyName:[propertyNames objectAtIndex:i] inObject:object];
+            if(!value)
+                continue;
+            if(i!=0 && delimiter)
+                [stringValue appendString:delimiter];
+            [SCDisplayStringFormatter appendValue:value toString:stringValue];
+        }
+    }
+    
+    if(stringValue.length > estimatedLength)
+        estimatedLength = stringValue.length;
+    
+    return stringValue;
+}
+
+@end
+
+
+
 @interface SCModelCenter ()
 
 - (void)registerForKeyboardNotifications;
 - (void)unregisterKeyboardNotifications;
 - (void)keyboardWillShow:(NSNotification *)aNotification;
 - (void)keyboardWillHide:(NSNotification *)aNotification;
+- (BOOL)isKeyboardIssuerOnScreen;
 
 @end
 
@@ -816,7 +1365,7 @@
 		keyboardIssuer = nil;
 		[self registerForKeyboardNotifications];
 		
-		modelsSet = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
+		viewControllerModels = [NSMapTable weakToStrongObjectsMapTable];
 	}
 	
 	return self;
@@ -825,7 +1374,6 @@
 - (void)dealloc
 {
 	[self unregisterKeyboardNotifications];
-	CFRelease(modelsSet);
 }
 
 - (void)registerForKeyboardNotifications
@@ -841,47 +1389,104 @@
 	[[NSNotificationCenter defaultCenter] removeObserver:self];
 }
 
+- (BOOL)isKeyboardIssuerOnScreen
+{
+    UIViewController *issuer = self.keyboardIssuer;
+    
+    return (issuer && issuer.isViewLoaded && issuer.view.window);
+}
+
 - (void)keyboardWillShow:(NSNotification *)aNotification
 {
-	if(!self.keyboardIssuer)
+	if(![self isKeyboardIssuerOnScreen])
 		return;
 	
-	for(SCTableViewModel *model in (__bridge id)modelsSet)
-		if(model.viewController == self.keyboardIssuer)
-			[model keyboardWillShow:aNotification];
+	for(SCTableViewModel *model in [self modelsForViewController:self.keyboardIssuer])
+		[model keyboardWillShow:aNotification];
 }
 
 - (void)keyboardWillHide:(NSNotification *)aNotification
 {
-	if(!self.keyboardIssuer)
+	if(![self isKeyboardIssuerOnScreen])
 		return;
 	
-	for(SCTableViewModel *model in (__bridge id)modelsSet)
-		if(model.viewController == self.keyboardIssuer)
-			[model keyboardWillHide:aNotification];
+	for(SCTableViewModel *model in [self modelsForViewController:self.keyboardIssuer])
+		[model keyboardWillHide:aNotification];
 }
 
 
 
+- (void)registerModel:(SCTableViewModel *)model forViewController:(UIViewController *)viewController
+{
+    if(!model || !viewController)
+        return;
+    
+    NSPointerArray *models = [viewControllerModels objectForKey:viewController];
+    if(!models)
+    {
+        models = [NSPointerArray weakObjectsPointerArray];
+        [viewControllerModels setObject:models forKey:viewController];
+    }
+    [models compact];
+    for(NSUInteger i=0; i<models.count; i++)
+    {
+        if([models pointerAtIndex:i] == (__bridge void *)model)
+            return;
+    }
+    [models addPointer:(__bridge void *)model];
+}
+
+- (void)unregisterModel:(SCTableViewModel *)model fromViewController:(UIViewController *)viewController
+{
+    if(!model || !viewController)
+        return;
+    
+    NSPointerArray *models = [viewControllerModels objectForKey:viewController];
+    for(NSUInteger i=0; i<models.count; i++)
+    {
+        if([models pointerAtIndex:i] == (__bridge void *)model)
+        {
+            [models removePointerAtIndex:i];
+            break;
+        }
+    }
+    [models compact];
+    if(!models.count)
+        [viewControllerModels removeObjectForKey:viewController];
+}
+
 - (void)registerModel:(SCTableViewModel *)model
 {
-    CFSetAddValue(modelsSet, (__bridge const void *)model);
+    [self registerModel:model forViewController:model.viewController];
 }
 
 - (void)unregisterModel:(SCTableViewModel *)model
 {
-    CFSetRemoveValue(modelsSet, (__bridge const void *)model);
+    [self unregisterModel:model fromViewController:model.viewController];
 }
 
 - (SCTableViewModel *)modelForViewController:(UIViewController *)viewController
 {
-    for(SCTableViewModel *model in (__bridge id)modelsSet)
-        if(model.viewController == viewController)
-            return model;
+    if(!viewController)
+        return nil;
     
+    // models are kept in registration order, so the first one registered wins
+    for(SCTableViewModel *model in [viewControllerModels objectForKey:viewController])
+    {
+        if(model)
+            return model;
+    }
     return nil;
 }
 
+- (NSArray *)modelsForViewController:(UIViewController *)viewController
+{
+    if(!viewController)
+        return nil;
+    
+    return [[viewControllerModels objectForKey:viewController] allObjects];
+}
+
 @end
 
 
@@ -312,6 +312,9 @@ When this property is set to YES, a full trailing swipe in the cell row performs
 /** Method called internally. */
 - (void)setIsCustomBoundProperty:(BOOL)custom;
 
+/** Returns the key paths of boundObject that the cell displays, so that the owner model can observe them when its observesBoundObjects property is TRUE. Subclasses that display values from other key paths should override this method and add them to super's return value. Method called internally. */
+- (NSArray *)observedBoundKeyPaths;
+
 /** Method called internally. */
 - (void)setNeedsCommit:(BOOL)needsCommit;
 
@@ -351,6 +354,9 @@ When this property is set to YES, a full trailing swipe in the cell row performs
 /** Marks the cell as a special cell. */
 - (void)markCellAsSpecial;
 
+/** Returns the height explicitly assigned to the cell (UITableViewAutomaticDimension if none), as opposed to the height property which may be calculated from the cell's contents. Method called internally. */
+- (CGFloat)assignedHeight;
+
 /** 
  Method should be overridden by subclasses to support property attributes. 
  
@@ -1195,6 +1201,15 @@ When this property is set to YES, a full trailing swipe in the cell row performs
 /** The name of the selected image. */
 @property (nonatomic, copy) NSString *selectedImageName;
 
+/** The file format selected images are saved in. Default: SCImageFileFormatJPEG. */
+@property (nonatomic, readwrite) SCImageFileFormat imageFileFormat;
+
+/** The JPEG compression quality (0-1) selected images are saved with. Default: 0.8. */
+@property (nonatomic, readwrite) CGFloat imageCompressionQuality;
+
+/** If TRUE, selected images are named after a hash of their contents, so picking the same image again reuses its existing file. Only applies when neither the imageName nor the saveImage cell action is implemented. Default: FALSE. */
+@property (nonatomic, readwrite) BOOL namesImagesByContent;
+
 
 /** Resets the clearImageButton default layer styles such as corneRadius and borderWidth. */
 - (void)resetClearImageButtonStyles;
@@ -1203,10 +1218,10 @@ When this property is set to YES, a full trailing swipe in the cell row performs
 /// @name Internal Methods (should only be used by the framework or when subclassing)
 //////////////////////////////////////////////////////////////////////////////////////////
 
-/** Method responsible for saving the image to the given path. */
+/** Method responsible for saving the image to the given path. The default implementation encodes and writes the image on a background queue. */
 - (void)saveImage:(UIImage *)image toPath:(NSString *)imagePath;
 
-/** Method responsible for loading image from the given path. */
+/** Method responsible for synchronously loading the full size image from the given path. Unless this method is overridden (or the loadImage cell action is implemented), the cell itself displays a downsampled copy of the image that is loaded asynchronously. */
 - (UIImage *)loadImageFromPath:(NSString *)imagePath;
 
 /** Gets called when the 'Clear' button is tapped. */
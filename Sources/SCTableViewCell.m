@@ -243,6 +243,7 @@
     _boundObject = boundObject;
     
     [self resetInitialBoundValue];
+    [self.ownerSection cellValueStateDidChange:self];
 }
 
 - (void)setBoundPropertyName:(NSString *)boundPropertyName
@@ -250,6 +251,21 @@
     _boundPropertyName = boundPropertyName;
     
     [self resetInitialBoundValue];
+    [self.ownerSection cellValueStateDidChange:self];
+}
+
+- (void)setValueRequired:(BOOL)required
+{
+    valueRequired = required;
+    
+    [self.ownerSection cellValueStateDidChange:self];
+}
+
+- (void)setAutoValidateValue:(BOOL)autoValidate
+{
+    autoValidateValue = autoValidate;
+    
+    [self.ownerSection cellValueStateDidChange:self];
 }
 
 - (void)resetInitialBoundValue
@@ -267,6 +283,9 @@
         initialValue = nil;
     
     self.boundValue = initialValue;
+    
+    // value is back to its initial state, a new snapshot is taken on the next change
+    self.initialBoundValue = nil;
 }
 
 
@@ -328,6 +347,16 @@
 - (void)setNeedsCommit:(BOOL)needs
 {
     needsCommit = needs;
+    
+    [self.ownerSection cellValueStateDidChange:self];
+}
+
+- (void)setEnabled:(BOOL)_enabled
+{
+    enabled = _enabled;
+    
+    // disabled cells are always valid
+    [self.ownerSection cellValueStateDidChange:self];
 }
 
 - (void)setActiveDetailModel:(SCTableViewModel *)model
@@ -559,6 +588,8 @@
                 self.initialBoundValue = initialValue;
             else
                 self.initialBoundValue = [NSNull null];
+            
+            [self.ownerSection cellDidSnapshotInitialBoundValue:self];
         }
         
         if(self.boundObjectStore)
@@ -683,6 +714,8 @@
 	if(self.commitChangesLive)
 		[self commitChanges];
     
+    [self.ownerSection cellValueStateDidChange:self];
+    
 	NSIndexPath *indexPath = [self.ownerTableViewModel indexPathForCell:self];
 	if(activeDetailModel) // a custom detail view is defined
 	{
@@ -730,9 +763,16 @@
     isSpecialCell = TRUE;
 }
 
+- (CGFloat)assignedHeight
+{
+    return _height;
+}
+
 - (void)commitChanges
 {
 	needsCommit = FALSE;
+    
+    [self.ownerSection cellValueStateDidChange:self];
 }
 
 - (void)reloadBoundValue
@@ -740,6 +780,18 @@
 	// Does nothing, should be overridden by subclasses
 }
 
+- (NSArray *)observedBoundKeyPaths
+{
+    if(!self.boundObject || !self.boundPropertyName || _isCustomBoundProperty)
+        return nil;
+    if([SCUtilities isBasicDataTypeClass:[self.boundObject class]] || [self.boundObject isKindOfClass:[NSDictionary class]])
+        return nil;
+    if([self.boundPropertyName length] && [self.boundPropertyName characterAtIndex:0] == '~')
+        return nil;  // placeholder for a custom cell
+    
+    return [NSArray arrayWithObject:self.boundPropertyName];
+}
+
 - (void)setAttributesTo:(SCPropertyAttributes *)attributes
 {
 	self.imageView.image = attributes.imageView.image;
@@ -1363,6 +1415,8 @@
     NSMutableDictionary *_initialControlValues;  // used during rollback operations
     
     SCCustomCell *_operationsCell;  // used for cell resizing operations
+    
+    BOOL _hasInputControls;     // canBecomeFirstResponder state last reported to the owner model
 }
 
 // determines if the custom control is bound to either an object or a key
@@ -1691,6 +1745,7 @@
     [self.contentView layoutIfNeeded];
     
     // Set the correct preferredMaxLayoutWidth for all custom cell labels
+    BOOL hasInputControls = FALSE;
     for(UIView *customControl in self.contentView.subviews)
     {
         if([customControl isKindOfClass:[UILabel class]])
@@ -1698,6 +1753,16 @@
             UILabel *label = (UILabel *)customControl;
             label.preferredMaxLayoutWidth = CGRectGetWidth(label.frame);
         }
+        else
+            if([customControl isKindOfClass:[UITextField class]] || [customControl isKindOfClass:[UITextView class]])
+                hasInputControls = TRUE;
+    }
+    
+    // input controls added or removed change whether the cell can become first responder
+    if(hasInputControls != _hasInputControls)
+    {
+        _hasInputControls = hasInputControls;
+        [self.ownerTableViewModel invalidateFocusableRows];
     }
 
     [self didLayoutSubviews];
@@ -1723,6 +1788,22 @@
     [self loadBindingsIntoCustomControls];
 }
 
+//override superclass
+- (NSArray *)observedBoundKeyPaths
+{
+    if(!self.boundObject || [self.boundObject isKindOfClass:[NSDictionary class]])
+        return nil;
+    
+    NSMutableArray *keyPaths = [NSMutableArray arrayWithArray:[super observedBoundKeyPaths]];
+    for(NSString *propertyName in [self.objectBindings allValues])
+    {
+        if([propertyName length] && [propertyName characterAtIndex:0]!='~' && ![keyPaths containsObject:propertyName])
+            [keyPaths addObject:propertyName];
+    }
+    
+    return keyPaths;
+}
+
 //override superclass
 - (void)commitChanges
 {
@@ -1800,6 +1881,7 @@
         else
             [SCUtilities setValue:initialValue forPropertyName:propertyName inObject:self.boundObject];
     }
+    [_initialControlValues removeAllObjects];
 }
 
 - (BOOL)controlWithTagIsBound:(NSUInteger)controlTag
@@ -2135,16 +2217,16 @@
                                             if([SCUtilities isURLValid:(NSString *)controlValue])
                                             {
                                                 NSURL *imageURL = [NSURL URLWithString:(NSString *)controlValue];
+                                                NSInteger imageViewTag = imageView.tag;
                                                 
-                                                // Load image asynchronously
-                                                dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0ul);
-                                                dispatch_async(queue, ^{
-                                                    NSData * imageData = [NSData dataWithContentsOfURL:imageURL];
-                                                    dispatch_async(dispatch_get_main_queue(), ^{
-                                                        UIImage *image = [UIImage imageWithData:imageData];
-                                                        [imageView setImage:image];
-                                                    });
-                                                });
+                                                // Load image asynchronously (shares any download started when the row was prefetched)
+                                                imageView.image = nil;
+                                                [SCUtilities loadImageWithURL:imageURL completion:^(UIImage *image)
+                                                 {
+                                                     // make sure the cell hasn't been reused for another object in the meantime
+                                                     if([[self boundValueForControlWithTag:imageViewTag] isEqual:controlValue])
+                                                         [imageView setImage:image];
+                                                 }];
                                             }
                                             else
                                             {
@@ -2165,6 +2247,8 @@
         if(!value)
             value = [NSNull null];
         [_initialControlValues setValue:value forKey:propertyName];
+        
+        [self.ownerSection cellDidSnapshotInitialBoundValue:self];
     }
 }
 
@@ -2845,6 +2929,17 @@
 
 
 
+@interface SCTextViewCell ()
+{
+    CGFloat _lastTextViewHeight;    // height the text view was last laid out or resized with
+    BOOL _heightUpdatePending;
+}
+
+- (void)updateCellHeight;
+
+@end
+
+
 @implementation SCTextViewCell
 
 @synthesize minimumHeight;
@@ -3062,7 +3157,8 @@
 	
     // don't check for self.controlCreatedInIB here as it's already taken care of in the textView size methods
     
-    self.textView.frame = CGRectMake([self textViewXCoord], [self textViewYCoord], [self textViewWidth], [self textViewHeight]);
+    _lastTextViewHeight = [self textViewHeight];
+    self.textView.frame = CGRectMake([self textViewXCoord], [self textViewYCoord], [self textViewWidth], _lastTextViewHeight);
     
     if([self.textLabel.text length])
     {
@@ -3185,16 +3281,37 @@
 	[self cellValueChanged];
     
     
-    // Resize cell if needed
+    // Resize cell only if the text view's line count has changed
     if(self.autoResize)
     {
-        [self.ownerTableViewModel.tableView beginUpdates];
-        [self.ownerTableViewModel.tableView endUpdates];
-        
-        [self scrollToFocusCaretForTextView:self.textView];
+        CGFloat textViewHeight = [self textViewHeight];
+        if(textViewHeight != _lastTextViewHeight)
+        {
+            _lastTextViewHeight = textViewHeight;
+            
+            // coalesce all changes within the same run loop turn into a single table update
+            if(!_heightUpdatePending)
+            {
+                _heightUpdatePending = TRUE;
+                [self performSelector:@selector(updateCellHeight) withObject:nil afterDelay:0];
+            }
+        }
+        else
+        {
+            [self scrollToFocusCaretForTextView:self.textView];
+        }
     }
 }
 
+- (void)updateCellHeight
+{
+    _heightUpdatePending = FALSE;
+    
+    [self.ownerTableViewModel updateHeightForCell:self];
+    
+    [self scrollToFocusCaretForTextView:self.textView];
+}
+
 @end
 
 
@@ -4027,6 +4144,17 @@
     [[UIDevice currentDevice] endGeneratingDeviceOrientationNotifications];
 }
 
+- (void)setDisplayDatePickerAsInputAccessoryView:(BOOL)display
+{
+    if(display == _displayDatePickerAsInputAccessoryView)
+        return;
+    
+    _displayDatePickerAsInputAccessoryView = display;
+    
+    // canBecomeFirstResponder depends on this setting
+    [self.ownerTableViewModel invalidateFocusableRows];
+}
+
 
 //overrides superclass
 - (BOOL)canBecomeFirstResponder
@@ -4308,12 +4436,21 @@
 @interface SCImagePickerCell ()
 {
     UIImageView *_detailImageView;
+    
+    UIImage *_displayImage;             // downsampled image displayed by the cell
+    NSString *_displayImageName;        // the selectedImageName _displayImage belongs to
+    NSString *_loadingDisplayImageName; // the selectedImageName being loaded asynchronously
+    UIImage *_imageBeingNamed;          // picked image whose content based name is still being computed
 }
 
 @property (nonatomic, readonly) UIImageView *effectiveImageView;
 
 - (NSString *)selectedImagePath;
 - (void)setCachedImage;
+- (BOOL)loadsImagesSynchronously;
+- (void)loadDisplayImage;
+- (void)didFinishSelectingImage;
+- (void)imageNamingStateDidChange;
 - (void)displayImagePicker;
 - (void)displayImageInDetailView;
 - (void)addImageViewToDetailView:(UIViewController *)detailView;
@@ -4336,6 +4473,9 @@
 @synthesize autoPositionClearImageButton;
 @synthesize textLabelFrame;
 @synthesize imageViewFrame;
+@synthesize imageFileFormat = _imageFileFormat;
+@synthesize imageCompressionQuality = _imageCompressionQuality;
+@synthesize namesImagesByContent = _namesImagesByContent;
 
 + (instancetype)cellWithText:(NSString *)cellText boundObject:(NSObject *)object imageNamePropertyName:(NSString *)propertyName
 {
@@ -4361,6 +4501,14 @@
 	askForSourceType = TRUE;
 	selectedImageName = nil;
 	autoPositionImageView = TRUE;
+    
+    _imageFileFormat = SCImageFileFormatJPEG;
+    _imageCompressionQuality = 0.8f;
+    _namesImagesByContent = FALSE;
+    _displayImage = nil;
+    _displayImageName = nil;
+    _loadingDisplayImageName = nil;
+    _imageBeingNamed = nil;
 	
 	clearImageButton = [UIButton buttonWithType:UIButtonTypeCustom];
 	clearImageButton.frame = CGRectMake(0, 0, 120, 25);
@@ -4393,8 +4541,7 @@
 {
 	if( (self=[self initWithText:cellText boundObject:object boundPropertyName:propertyName]) )
 	{
-		self.selectedImageName = (NSString *)self.boundValue;
-		[self setCachedImage];
+		self.selectedImageName = (NSString *)self.boundValue;  // the image itself is loaded when the cell is laid out
 	}
 	return self;
 }
@@ -4437,17 +4584,20 @@
 	
     NSIndexPath *indexPath = [self.ownerTableViewModel indexPathForCell:self];
     NSString *imagePath = [self selectedImagePath];
-    UIImage *image;
-    if(self.cellActions.loadImage)
-        image = self.cellActions.loadImage(self, indexPath, imagePath);
-    else
-        if(self.ownerSection.cellActions.loadImage)
-            image = self.ownerSection.cellActions.loadImage(self, indexPath, imagePath);
+    UIImage *image = [SCUtilities pendingImageForPath:imagePath];  // the file might not have been written yet
+    if(!image)
+    {
+        if(self.cellActions.loadImage)
+            image = self.cellActions.loadImage(self, indexPath, imagePath);
         else
-            if(self.ownerTableViewModel.cellActions.loadImage)
-                image = self.ownerTableViewModel.cellActions.loadImage(self, indexPath, imagePath);
-    else
-        image = [self loadImageFromPath:imagePath];
+            if(self.ownerSection.cellActions.loadImage)
+                image = self.ownerSection.cellActions.loadImage(self, indexPath, imagePath);
+            else
+                if(self.ownerTableViewModel.cellActions.loadImage)
+                    image = self.ownerTableViewModel.cellActions.loadImage(self, indexPath, imagePath);
+                else
+                    image = [self loadImageFromPath:imagePath];
+    }
     
 	if(image)
 	{
@@ -4455,6 +4605,49 @@
 	}
 }
 
+- (BOOL)loadsImagesSynchronously
+{
+    if(self.cellActions.loadImage || self.ownerSection.cellActions.loadImage || self.ownerTableViewModel.cellActions.loadImage)
+        return TRUE;
+    
+    // subclasses overriding loadImageFromPath: keep loading synchronously
+    return [self methodForSelector:@selector(loadImageFromPath:)] != [SCImagePickerCell instanceMethodForSelector:@selector(loadImageFromPath:)];
+}
+
+- (void)loadDisplayImage
+{
+    if([self loadsImagesSynchronously])
+    {
+        [self setCachedImage];
+        return;
+    }
+    
+    NSString *imageName = self.selectedImageName;
+    if([_loadingDisplayImageName isEqualToString:imageName])
+        return;  // already loading
+    _loadingDisplayImageName = imageName;
+    
+    CGFloat pointSize;
+    if(self.customImageView)
+        pointSize = fmax(self.customImageView.bounds.size.width, self.customImageView.bounds.size.height);
+    else
+        pointSize = self.bounds.size.height;
+    if(pointSize < 44)
+        pointSize = 44;  // cell not laid out yet, assume the standard row height
+    
+    [SCUtilities loadImageFromPath:[self selectedImagePath] maxPixelSize:(pointSize * [UIScreen mainScreen].scale) completion:^(UIImage *image)
+     {
+         if(![imageName isEqualToString:self.selectedImageName])
+             return;  // cell has been reused or a different image selected
+         
+         self->_loadingDisplayImageName = nil;
+         self->_displayImage = image;
+         self->_displayImageName = imageName;
+         if(image)
+             [self setNeedsLayout];
+     }];
+}
+
 - (NSString *)selectedImagePath
 {
 	if(!self.selectedImageName)
@@ -4474,12 +4667,18 @@
 		if(self.displayImageNameAsCellText)
 			self.textLabel.text = self.selectedImageName;
 		
-		if(!cachedImage)
-			[self setCachedImage];
+        UIImage *image = cachedImage;
+        if(!image && [_displayImageName isEqualToString:self.selectedImageName])
+            image = _displayImage;
+		if(!image)
+        {
+			[self loadDisplayImage];
+            image = cachedImage;
+        }
 		
-		self.effectiveImageView.image = cachedImage;
+		self.effectiveImageView.image = image;
 		
-		if(cachedImage)
+		if(image)
 		{
             if(!self.customImageView)
             {
@@ -4491,7 +4690,7 @@
                 self.imageView.frame = imgframe;
             }
 			
-			self.effectiveImageView.image = cachedImage;
+			self.effectiveImageView.image = image;
 		}
 	}
 	else
@@ -4528,6 +4727,15 @@
 	[super commitChanges];
 }
 
+//overrides superclass
+- (BOOL)valueIsValid
+{
+    if(_imageBeingNamed)
+        return FALSE;
+    //else
+    return [super valueIsValid];
+}
+
 //overrides superclass
 - (BOOL)getValueIsValid
 {
@@ -4674,6 +4882,13 @@
 {
 	self.selectedImageName = nil;
 	cachedImage = nil;
+    if(_imageBeingNamed)
+    {
+        _imageBeingNamed = nil;
+        [self imageNamingStateDidChange];
+    }
+    _displayImage = nil;
+    _displayImageName = nil;
 	[_detailImageView removeFromSuperview];
     _detailImageView = nil;
 	
@@ -4704,11 +4919,15 @@
 
 - (void)saveImage:(UIImage *)image toPath:(NSString *)imagePath
 {
-    [UIImageJPEGRepresentation(image, 80) writeToFile:imagePath atomically:YES];
+    [SCUtilities saveImage:image toPath:imagePath format:self.imageFileFormat compressionQuality:self.imageCompressionQuality completion:nil];
 }
 
 - (UIImage *)loadImageFromPath:(NSString *)imagePath
 {
+    UIImage *pendingImage = [SCUtilities pendingImageForPath:imagePath];
+    if(pendingImage)
+        return pendingImage;
+    //else
     return [UIImage imageWithContentsOfFile:imagePath];
 }
 
@@ -4818,6 +5037,37 @@
     if(image)
     {
         cachedImage = image;
+        _displayImage = nil;
+        _displayImageName = nil;
+        
+        BOOL hasImageNameAction = self.cellActions.imageName || self.ownerSection.cellActions.imageName || self.ownerTableViewModel.cellActions.imageName;
+        BOOL hasSaveImageAction = self.cellActions.saveImage || self.ownerSection.cellActions.saveImage || self.ownerTableViewModel.cellActions.saveImage;
+        if(self.namesImagesByContent && !hasImageNameAction && !hasSaveImageAction)
+        {
+            // the name is only known once the image has been encoded, so the cell's value is invalid (and Done disabled) until then
+            _imageBeingNamed = image;
+            [self imageNamingStateDidChange];
+            
+            NSString *directoryPath = [NSHomeDirectory() stringByAppendingPathComponent:@"Documents"];
+            [SCUtilities saveImage:image inDirectory:directoryPath format:self.imageFileFormat compressionQuality:self.imageCompressionQuality completion:^(NSString *imageName)
+             {
+                 if(self->_imageBeingNamed != image)
+                     return;  // a different image was selected or the image was cleared meanwhile
+                 
+                 self->_imageBeingNamed = nil;
+                 if(imageName)
+                 {
+                     self.selectedImageName = imageName;
+                     [self didFinishSelectingImage];
+                 }
+                 else
+                 {
+                     self->cachedImage = nil;
+                     [self imageNamingStateDidChange];
+                 }
+             }];
+            return;
+        }
         
         if(self.cellActions.imageName)
             self.selectedImageName = self.cellActions.imageName(self, indexPath);
@@ -4852,21 +5102,35 @@
                 else
                     [self saveImage:image toPath:imagePath];
         
-        [self layoutSubviews];
-        
-        
-        // reload cell
-        if(indexPath)
-        {
-            NSArray *indexPaths = [NSArray arrayWithObject:indexPath];
-            [self.ownerTableViewModel.tableView reloadRowsAtIndexPaths:indexPaths
-                                                      withRowAnimation:UITableViewRowAnimationNone];
-        }
-        
-        [self cellValueChanged];
+        [self didFinishSelectingImage];
     }
 }
 
+- (void)imageNamingStateDidChange
+{
+    [self.ownerSection cellValueStateDidChange:self];
+    
+    if(self.ownerTableViewModel.commitButton)
+        self.ownerTableViewModel.commitButton.enabled = self.ownerTableViewModel.valuesAreValid;
+}
+
+- (void)didFinishSelectingImage
+{
+    [self layoutSubviews];
+    
+    
+    // reload cell
+    NSIndexPath *indexPath = [self.ownerTableViewModel indexPathForCell:self];
+    if(indexPath)
+    {
+        NSArray *indexPaths = [NSArray arrayWithObject:indexPath];
+        [self.ownerTableViewModel.tableView reloadRowsAtIndexPaths:indexPaths
+                                                  withRowAnimation:UITableViewRowAnimationNone];
+    }
+    
+    [self cellValueChanged];
+}
+
 
 - (void)handleDetailViewControllerWillPresent:(UIViewController *)detailViewController
 {
@@ -6191,9 +6455,7 @@
 	
 	if(self.boundObject && self.objectDefinition.descriptionPropertyName)
 	{
-		self.detailTextLabel.text = [SCUtilities stringValueForPropertyName:self.objectDefinition.descriptionPropertyName
-																inObject:self.boundObject
-											separateValuesUsingDelimiter:@" "];
+		self.detailTextLabel.text = [self.objectDefinition descriptionValueForObject:self.boundObject];
 	}
 }
 
@@ -200,6 +200,9 @@
 /** Called by master model to have the view controller lose focus. */
 - (void)loseFocus;
 
+/** Method called internally by the framework to reset a dismissed view controller so that it can be presented again. */
+- (void)prepareForReuse;
+
 @end
 
 
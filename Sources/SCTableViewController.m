@@ -44,6 +44,10 @@
     
     BOOL _leftBarButtonItemInitialEnabledState;
     BOOL _rightBarButtonItemInitialEnabledState;
+    
+    NSDictionary *_resolvedIBDataDefinitions;       // local definitions merged with the master's, shared down the detail chain
+    NSDictionary *_resolvedMasterIBDataDefinitions; // the master's resolved definitions used to build _resolvedIBDataDefinitions
+    NSDictionary *_ibSTVSections;                   // parsed ibSTVSectionsString
 }
 
 /** Receives the ibSTVSectionsString from IB **/
@@ -52,6 +56,11 @@
 // Actual Data definitions converted from _STV_ibDataDefinitions NSDictionary objects
 @property (nonatomic, retain, readonly) NSDictionary *ibDataDefinitions;
 
+// The ibSTVSectionsString parsed into section dictionaries keyed by section index
+@property (nonatomic, readonly) NSDictionary *ibSTVSections;
+
++ (NSDictionary *)STVSectionsForIBSectionsString:(NSString *)sectionsString;
+
 @end
 
 
@@ -161,23 +170,104 @@
         [dataDefinition resolveibRelationshipsUsingDictionary:convertedDefinitions];
     }
     
-    _ibDataDefinitions = convertedDefinitions;
+    _ibDataDefinitions = [convertedDefinitions copy];
+    
+    // invalidate resolved definitions
+    _resolvedIBDataDefinitions = nil;
+    _resolvedMasterIBDataDefinitions = nil;
 }
 
 - (NSDictionary *)ibDataDefinitions
 {
     // return both local and any remote data definitions
     
-    NSMutableDictionary *dataDefinitions = [NSMutableDictionary dictionaryWithDictionary:_ibDataDefinitions];
-    
+    NSDictionary *masterDefinitions = nil;
     if(self.tableViewModel.masterModel && [self.tableViewModel.masterModel.viewController isKindOfClass:[SCTableViewController class]])
     {
         SCTableViewController *masterViewController = (SCTableViewController *)self.tableViewModel.masterModel.viewController;
         
-        [dataDefinitions addEntriesFromDictionary:masterViewController.ibDataDefinitions];
+        masterDefinitions = masterViewController.ibDataDefinitions;
+    }
+    
+    // Only re-merge if the master's resolved definitions have changed
+    if(!_resolvedIBDataDefinitions || masterDefinitions!=_resolvedMasterIBDataDefinitions)
+    {
+        if(!masterDefinitions.count)
+        {
+            _resolvedIBDataDefinitions = _ibDataDefinitions ? _ibDataDefinitions : [NSDictionary dictionary];
+        }
+        else
+            if(!_ibDataDefinitions.count)
+            {
+                _resolvedIBDataDefinitions = masterDefinitions;   // share the master's definitions by reference
+            }
+            else
+            {
+                NSMutableDictionary *dataDefinitions = [NSMutableDictionary dictionaryWithDictionary:_ibDataDefinitions];
+                [dataDefinitions addEntriesFromDictionary:masterDefinitions];
+                _resolvedIBDataDefinitions = [dataDefinitions copy];
+            }
+        
+        _resolvedMasterIBDataDefinitions = masterDefinitions;
     }
     
-    return dataDefinitions;
+    return _resolvedIBDataDefinitions;
+}
+
+- (void)setIbSTVSectionsString:(NSString *)sectionsString
+{
+    _ibSTVSectionsString = [sectionsString copy];
+    
+    _ibSTVSections = nil;
+}
+
+- (NSDictionary *)ibSTVSections
+{
+    if(!_ibSTVSections && [self.ibSTVSectionsString length])
+        _ibSTVSections = [[self class] STVSectionsForIBSectionsString:self.ibSTVSectionsString];
+    
+    return _ibSTVSections;
+}
+
++ (NSDictionary *)STVSectionsForIBSectionsString:(NSString *)sectionsString
+{
+    // All instances of the same storyboard scene share the same sections string, so only parse it once
+    static NSCache *_parsedSectionsCache = nil;
+	@synchronized(self)
+	{
+		if(!_parsedSectionsCache)
+			_parsedSectionsCache = [[NSCache alloc] init];
+	}
+    
+    NSDictionary *STVSections = [_parsedSectionsCache objectForKey:sectionsString];
+    if(STVSections)
+        return STVSections;
+    
+    NSMutableDictionary *parsedSections = [NSMutableDictionary dictionary];
+    
+    NSArray *sectionStrings = [sectionsString componentsSeparatedByString:@"⬛︎"];
+    for(NSString *sectionString in sectionStrings)
+    {
+        NSMutableDictionary *sectionDictionary = [NSMutableDictionary dictionary];
+        
+        NSArray *valuePairs = [sectionString componentsSeparatedByString:@"・"];
+        for(NSString *pairString in valuePairs)
+        {
+            NSArray *pair = [pairString componentsSeparatedByString:@"➡︎"];
+            if(pair.count!=2)
+                continue;
+            [sectionDictionary setValue:[pair objectAtIndex:1] forKey:[pair objectAtIndex:0]];
+        }
+        
+        NSString *index = [sectionDictionary valueForKey:kSectionIndexKey];
+        if(index)
+            [parsedSections setValue:[sectionDictionary copy] forKey:index];
+    }
+    
+    STVSections = [parsedSections copy];
+    [_parsedSectionsCache setObject:STVSections forKey:sectionsString];
+    
+    return STVSections;
 }
 
 - (void)setTableView:(UITableView *)tableView
@@ -411,31 +501,11 @@
     // Check if there is any static table view content and add it to the model
     NSUInteger sectionNumber = [self numberOfSectionsInTableView:self.tableView];
     
-    NSMutableDictionary *STVSections = nil;
-    if(sectionNumber && [self.ibSTVSectionsString length])
-    {
-        // prepare the STVSections dictionary
-        STVSections = [NSMutableDictionary dictionary];
-        
-        NSArray *sectionStrings = [self.ibSTVSectionsString componentsSeparatedByString:@"⬛︎"];
-        for(NSString *sectionString in sectionStrings)
-        {
-            NSMutableDictionary *sectionDictionary = [NSMutableDictionary dictionary];
-            
-            NSArray *valuePairs = [sectionString componentsSeparatedByString:@"・"];
-            for(NSString *pairString in valuePairs)
-            {
-                NSArray *pair = [pairString componentsSeparatedByString:@"➡︎"];
-                if(pair.count!=2)
-                    continue;
-                [sectionDictionary setValue:[pair objectAtIndex:1] forKey:[pair objectAtIndex:0]];
-            }
-            
-            NSString *index = [sectionDictionary valueForKey:kSectionIndexKey];
-            if(index)
-                [STVSections setValue:sectionDictionary forKey:index];
-        }
-    }
+    NSDictionary *STVSections = nil;
+    if(sectionNumber)
+        STVSections = self.ibSTVSections;
+    
+    NSDictionary *dataDefinitions = self.ibDataDefinitions;
     
     BOOL addButtonConnected = FALSE;
     
@@ -452,7 +522,7 @@
             
             NSString *dataDefinitionID = [sectionDictionary valueForKey:kSectionDataDefIdKey];
             
-            SCDataDefinition *dataDefinition = [self.ibDataDefinitions valueForKey:dataDefinitionID];
+            SCDataDefinition *dataDefinition = [dataDefinitions valueForKey:dataDefinitionID];
             
             if(!dataDefinition && [sectionType isEqualToString:@"SCArrayOfStringsSection"])
                 dataDefinition = [SCStringDefinition definition];
@@ -729,9 +799,10 @@
 
 - (SCDataDefinition *)dataDefinitionWithIBName:(NSString *)ibName
 {
-    for(NSString *key in self.ibDataDefinitions)
+    NSDictionary *dataDefinitions = self.ibDataDefinitions;
+    for(NSString *key in dataDefinitions)
     {
-        SCDataDefinition *dataDefinition = [self.ibDataDefinitions valueForKey:key];
+        SCDataDefinition *dataDefinition = [dataDefinitions valueForKey:key];
         if([dataDefinition.ibName isEqualToString:ibName])
             return dataDefinition;
     }
@@ -1353,6 +1424,11 @@
         return;
     }
     
+    if(cancelValue)
+        [self.tableViewModel discardEditingSessions];
+    else
+        [self.tableViewModel commitEditingSessions];
+    
     if(_hasFocus)
     {
         [self loseFocus];
@@ -1445,6 +1521,20 @@
     self.delegate = nil;
 }
 
+- (void)prepareForReuse
+{
+    _state = SCViewControllerStateNew;
+    _cancelButtonTapped = FALSE;
+    _doneButtonTapped = FALSE;
+    _popoverController = nil;
+    
+    self.delegate = nil;
+    self.title = nil;
+    
+    if([self isViewLoaded])
+        [self.tableView setContentOffset:CGPointMake(0, -self.tableView.contentInset.top) animated:NO];
+}
+
 
 // overrides superclass
 - (BOOL)disablesAutomaticKeyboardDismissal
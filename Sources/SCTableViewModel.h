@@ -42,7 +42,7 @@
  SCTableViewCell. 
  */
 
-@interface SCTableViewModel : NSObject <UITableViewDataSource, UITableViewDelegate, UIScrollViewDelegate, SCInputAccessoryViewDelegate>
+@interface SCTableViewModel : NSObject <UITableViewDataSource, UITableViewDataSourcePrefetching, UITableViewDelegate, UIScrollViewDelegate, SCInputAccessoryViewDelegate>
 {
 	//internal
     NSIndexPath *lastReturnedCellIndexPath;     // used for optimization
@@ -135,7 +135,7 @@
 @property (nonatomic, strong) UIBarButtonItem *editButtonItem;
 
 /** 
- If TRUE, SCTableViewModel will automatically resize its tableView when the
+ If TRUE, SCTableViewModel will automatically adjust its tableView's content and scroll indicator insets when the
  keyboard appears. Property defualts to FALSE if viewController is a UITableViewController subclass,
  as UITableViewController will automatically handle the resizing. Otherwise, it defaults to TRUE.
  */
@@ -195,6 +195,12 @@
 /** The theme used to style the model's views. Default: nil. */
 @property (nonatomic, strong) SCTheme *theme;
 
+/** 
+ If TRUE, SCTableViewModel observes the bound object key paths displayed by its cells (such as boundPropertyName, the items' titlePropertyName and descriptionPropertyName, and custom cell objectBindings) using key-value observing. Changes made outside the UI are coalesced until the end of the current run loop turn, and then only the affected visible cells are refreshed in place. Affected off-screen cells are refreshed when they next appear. This is much cheaper than calling reloadBoundValues for single value changes. Default: FALSE.
+ @note Bound objects must be key-value observing compliant for the displayed key paths (e.g. Core Data managed objects or properties changed through their setters).
+ */
+@property (nonatomic, readwrite) BOOL observesBoundObjects;
+
 
 //////////////////////////////////////////////////////////////////////////////////////////
 /// @name Managing Sections
@@ -369,6 +375,11 @@
 /** Reload's the model's bound values in case the associated bound objects or keys valuea has changed by means other than the cells themselves (e.g. external custom code). */
 - (void)reloadBoundValues;
 
+/** 
+ The model keeps track of invalid and uncommitted cells incrementally as their values change, so that valuesAreValid and needsCommit don't need to re-validate every cell on every edit. Call this method to force a full re-validation in case a cell's validity depends on something other than its own value (e.g. a valueIsValid action that compares the values of two cells). 
+ */
+- (void)invalidateCellValueStates;
+
 //////////////////////////////////////////////////////////////////////////////////////////
 /// @name Miscellaneous
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -459,6 +470,27 @@
 /** Warning: Method must only be called internally by the framework. */
 - (void)clearLastReturnedCellData;
 
+/** Method called internally by sections whenever their valuesAreValid or needsCommit state might have changed. */
+- (void)sectionValueStateDidChange:(SCTableViewSection *)section;
+
+/** Method called internally by sections whenever their cell value states need to be fully recalculated. */
+- (void)invalidateSectionValueStates;
+
+/** Method called internally by sections when one of their cells first changes its bound value since binding. */
+- (void)sectionDidSnapshotInitialCellValues:(SCTableViewSection *)section;
+
+/** Method called internally by auto-resizing cells to have the table view update the cell's height. All other rows keep their last returned heights and are not re-measured. */
+- (void)updateHeightForCell:(SCTableViewCell *)cell;
+
+/** Method called internally by sections whenever cells are added, removed, or collapsed, and by cells whose ability to become first responder changes, so that the ordered index of rows that can become first responder is rebuilt on next navigation. */
+- (void)invalidateFocusableRows;
+
+/** Method called internally by the model's view controller when its Done button is tapped, to write the values collected by any SCUserDefaultsStore editing sessions the model started. */
+- (void)commitEditingSessions;
+
+/** Method called internally by the model's view controller when its Cancel button is tapped, to discard the values collected by any SCUserDefaultsStore editing sessions the model started. */
+- (void)discardEditingSessions;
+
 /** Warning: Method must only be called internally by the framework. */
 - (void)configureDetailModel:(SCTableViewModel *)detailModel;
 
@@ -513,6 +545,9 @@
 /** Method called internally. */
 - (void)styleCell:(SCTableViewCell *)cell atIndexPath:(NSIndexPath *)indexPath onlyStylePropertyNamesInSet:(NSSet *)propertyNames;
 
+/** Returns the theme style styleCell:atIndexPath:onlyStylePropertyNamesInSet: applies to cell, not counting changes made by willStyle actions. Method called internally. */
+- (NSString *)themeStyleForCell:(SCTableViewCell *)cell atIndexPath:(NSIndexPath *)indexPath;
+
 /** Method called internally. */
 - (void)configureCell:(SCTableViewCell *)cell atIndexPath:(NSIndexPath *)indexPath;
 
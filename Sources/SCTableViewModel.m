@@ -16,11 +16,57 @@
 #import "SCUserDefaultsStore.h"
 
 
+static void *SCBoundObjectObservationContext = &SCBoundObjectObservationContext;
+
+
 @interface SCTableViewModel ()
 {
     BOOL _loading;
+    
+    NSHashTable *_invalidSections;      // sections whose valuesAreValid is FALSE
+    NSHashTable *_uncommittedSections;  // sections whose needsCommit is TRUE
+    NSHashTable *_sweptSections;        // sections that re-validate their cells on every access
+    BOOL _sectionValueStatesStale;
+    NSUInteger _valueIsValidActionsGeneration;  // [SCCellActions valueIsValidActionsGeneration] the states were built with
+    
+    NSHashTable *_snapshotSections;     // sections with cells edited since binding
+    
+    NSHashTable *_editingSessionStores;     // user defaults stores this model started an editing session on
+    
+    NSMutableDictionary *_rowHeights;   // last height returned to the table view for each index path since the last reload or structural change
+    NSIndexPath *_resizingIndexPath;    // row being resized by updateHeightForCell:
+    
+    NSMutableArray *_focusableIndexPaths;           // ordered rows whose cells can become first responder, nil when stale
+    NSMutableDictionary *_focusableRowPositions;    // index path -> position in _focusableIndexPaths
+    BOOL _hasUnindexedSections;                     // TRUE if some sections generate their cells on demand
+    
+    UIEdgeInsets _contentInsetBeforeKeyboard;
+    UIEdgeInsets _scrollIndicatorInsetsBeforeKeyboard;
+    
+    NSMapTable *_cellObservations;      // cell -> array of observed (object, key path) pairs
+    NSMapTable *_observedObjectCells;   // observed object -> cells displaying it
+    NSHashTable *_changedCells;         // cells whose observed values changed since the last refresh
+    NSHashTable *_staleCells;           // off-screen cells that must reload their bound values before appearing
+    BOOL _boundObjectsRefreshScheduled;
+    
+    __weak UIViewController *_registeredViewController;    // view controller this model is registered under in SCModelCenter
 }
 
+- (CGFloat)calculatedHeightForRowAtIndexPath:(NSIndexPath *)indexPath;
+- (void)updateModelCenterRegistration;
+
+- (void)rebuildFocusableRows;
+- (NSIndexPath *)indexPathForFocusableRowAfterIndexPath:(NSIndexPath *)indexPath forward:(BOOL)forward rewind:(BOOL)rewind;
+- (void)updateInputAccessoryViewNavigationState;
+
+- (void)observeBoundObjectsForCell:(SCTableViewCell *)cell;
+- (void)stopObservingBoundObjectsForCell:(SCTableViewCell *)cell;
+- (void)stopObservingBoundObjectsForSection:(SCTableViewSection *)section;
+- (void)stopObservingAllBoundObjects;
+- (void)refreshChangedCells;
+
+- (NSDictionary *)rowIndexesBySectionForIndexPaths:(NSArray *)indexPaths;
+
 - (void)prepareSectionForOwnership:(SCTableViewSection *)section;
 - (void)callDidAddSectionActionsForSection:(SCTableViewSection *)section;
 - (void)addSectionForObject:(NSObject *)object withDataStore:(SCDataStore *)store usingGroup:(SCPropertyGroup *)group newObject:(BOOL)newObject;
@@ -95,6 +141,26 @@
         [self setRefreshControl:[[UIRefreshControl alloc] init]]; // call setter
         
         sections = [[NSMutableArray alloc] init];
+        _invalidSections = [NSHashTable weakObjectsHashTable];
+        _uncommittedSections = [NSHashTable weakObjectsHashTable];
+        _sweptSections = [NSHashTable weakObjectsHashTable];
+        _sectionValueStatesStale = TRUE;
+        _valueIsValidActionsGeneration = 0;
+        _snapshotSections = [NSHashTable weakObjectsHashTable];
+        _rowHeights = [NSMutableDictionary dictionary];
+        _editingSessionStores = [NSHashTable weakObjectsHashTable];
+        _resizingIndexPath = nil;
+        _focusableIndexPaths = nil;
+        _focusableRowPositions = nil;
+        _hasUnindexedSections = FALSE;
+        
+        _observesBoundObjects = FALSE;
+        _cellObservations = [NSMapTable strongToStrongObjectsMapTable];
+        _observedObjectCells = [NSMapTable mapTableWithKeyOptions:(NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality) valueOptions:NSPointerFunctionsStrongMemory];
+        _changedCells = [NSHashTable weakObjectsHashTable];
+        _staleCells = [NSHashTable weakObjectsHashTable];
+        _boundObjectsRefreshScheduled = FALSE;
+        
 		activeCell = nil;
         activeCellIndexPath = nil;
         activeCellControl = nil;
@@ -113,9 +179,10 @@
         _cellActions = [[SCCellActions alloc] init];
         
         _theme = nil;
-		
-		// Register with the shared model center
-		[[SCModelCenter sharedModelCenter] registerModel:self];
+        
+        // Registered with the shared model center once the table view has a view controller
+        _registeredViewController = nil;
+        [self updateModelCenterRegistration];
     }
     return self;
 }
@@ -133,13 +200,16 @@
 - (void)dealloc
 {
 	// Unregister from the shared model center
-    [[SCModelCenter sharedModelCenter] unregisterModel:self];
+    [[SCModelCenter sharedModelCenter] unregisterModel:self fromViewController:_registeredViewController];
+    
+    [self stopObservingAllBoundObjects];
 }
 
 
 - (void)setTableView:(UITableView *)tableView
 {
     _tableView = tableView;
+    [self updateModelCenterRegistration];
     
     if(_tableView)
     {
@@ -151,6 +221,9 @@
         
         _tableView.dataSource = self;
         _tableView.delegate = self;
+        if (@available(iOS 10.0, *)) {
+            _tableView.prefetchDataSource = self;
+        }
         _tableView.allowsSelectionDuringEditing = TRUE;
     }
     
@@ -209,10 +282,6 @@
 
 - (UIViewController *)viewController
 {
-    if(!self.trueTableView)
-        return nil;
-    
-    
     id vc = [self.trueTableView nextResponder];
     while(![vc isKindOfClass:[UIViewController class]] && vc!=nil)
     {
@@ -222,6 +291,18 @@
     return vc;
 }
 
+- (void)updateModelCenterRegistration
+{
+    // keep the model center's view controller -> model registry current
+    UIViewController *vc = self.viewController;
+    if(vc == _registeredViewController)
+        return;
+    
+    [[SCModelCenter sharedModelCenter] unregisterModel:self fromViewController:_registeredViewController];
+    [[SCModelCenter sharedModelCenter] registerModel:self forViewController:vc];
+    _registeredViewController = vc;
+}
+
 - (void)setInputAccessoryView:(SCInputAccessoryView *)accessoryView
 {
     _inputAccessoryView = accessoryView;
@@ -423,15 +504,22 @@
 {
 	autoSortSections = autoSort;
 	if(autoSort)
+    {
 		[sections sortUsingSelector:@selector(compare:)];
+        [self invalidateFocusableRows];
+    }
 }
 
 
 - (void)rollbackToInitialCellValues
 {
-    for(SCTableViewSection *section in sections)
+    // Only sections whose cells were edited since binding hold snapshots to restore
+    NSArray *snapshotSections = [_snapshotSections allObjects];
+    [_snapshotSections removeAllObjects];
+    for(SCTableViewSection *section in snapshotSections)
     {
-        [section rollbackToInitialCellValues];
+        if(section.ownerTableViewModel == self)
+            [section rollbackToInitialCellValues];
     }
 }
 
@@ -491,6 +579,8 @@
 	
     activeCell = cell;
     activeCellIndexPath = [self indexPathForCell:activeCell];
+    
+    [self updateInputAccessoryViewNavigationState];
 	
     if(![activeCell isKindOfClass:[SCCustomCell class]])
         self.activeCellControl = nil;
@@ -665,6 +755,8 @@
 - (void)prepareSectionForOwnership:(SCTableViewSection *)section
 {
     section.ownerTableViewModel = self;
+    [self invalidateSectionValueStates];
+    [self invalidateFocusableRows];
     
     if(self.tableView.editing && [section isKindOfClass:[SCObjectSection class]])
     {
@@ -748,7 +840,15 @@
 
 - (void)removeSectionAtIndex:(NSUInteger)index
 {
+    SCTableViewSection *section = [sections objectAtIndex:index];
+    [_invalidSections removeObject:section];
+    [_uncommittedSections removeObject:section];
+    [_sweptSections removeObject:section];
+    [_snapshotSections removeObject:section];
+    [self stopObservingBoundObjectsForSection:section];
+    
 	[sections removeObjectAtIndex:index];
+    [self invalidateFocusableRows];
     
     if(self.modelActions.didRemoveSection)
         self.modelActions.didRemoveSection(self, index);
@@ -759,7 +859,14 @@
     activeCell = nil;
     activeCellControl = nil;
     
+    [self stopObservingAllBoundObjects];
 	[sections removeAllObjects];
+    [_invalidSections removeAllObjects];
+    [_uncommittedSections removeAllObjects];
+    [_sweptSections removeAllObjects];
+    [_snapshotSections removeAllObjects];
+    _sectionValueStatesStale = FALSE;
+    [self invalidateFocusableRows];
 }
 
 - (void)generateSectionsForObject:(NSObject *)object withDefinition:(SCDataDefinition *)definition
@@ -1239,30 +1346,43 @@
     NSIndexPath *currentCellIndexPath = self.activeCellIndexPath;
     SCTableViewCell *nextCell = nil;
     NSIndexPath *nextCellIndexPath = nil;
-    while( (nextCellIndexPath = [self indexPathForCellAfterCellAtIndexPath:currentCellIndexPath rewind:rewind])) 
+    
+    if(!_focusableIndexPaths)
+        [self rebuildFocusableRows];
+    if(!_hasUnindexedSections)
     {
-        if(!nextCellIndexPath)
+        nextCellIndexPath = [self indexPathForFocusableRowAfterIndexPath:currentCellIndexPath forward:TRUE rewind:rewind];
+        if(nextCellIndexPath)
+            nextCell = [self cellAtIndexPath:nextCellIndexPath];
+    }
+    else
+    {
+        // some sections generate their cells on demand, check each cell in turn
+        while( (nextCellIndexPath = [self indexPathForCellAfterCellAtIndexPath:currentCellIndexPath rewind:rewind])) 
         {
-            nextCell = nil;
-            break;
-        }
+            if(!nextCellIndexPath)
+            {
+                nextCell = nil;
+                break;
+            }
         
-        nextCell = [self cellAtIndexPath:nextCellIndexPath];
-        if([nextCell canBecomeFirstResponder])
-            break;
+            nextCell = [self cellAtIndexPath:nextCellIndexPath];
+            if([nextCell canBecomeFirstResponder])
+                break;
         
-        //else
+            //else
         
-        // prevent infinite loop
-        if(nextCellIndexPath.row==self.activeCellIndexPath.row && nextCellIndexPath.section==self.activeCellIndexPath.section)
-        {
+            // prevent infinite loop
+            if(nextCellIndexPath.row==self.activeCellIndexPath.row && nextCellIndexPath.section==self.activeCellIndexPath.section)
+            {
+                nextCell = nil;
+                break;
+            }
+        
+            currentCellIndexPath = nextCellIndexPath;
             nextCell = nil;
-            break;
+            nextCellIndexPath = nil;
         }
-        
-        currentCellIndexPath = nextCellIndexPath;
-        nextCell = nil;
-        nextCellIndexPath = nil;
     }
     
     if(nextCell)
@@ -1296,30 +1416,43 @@
     NSIndexPath *currentCellIndexPath = self.activeCellIndexPath;
     SCTableViewCell *prevCell = nil;
     NSIndexPath *prevCellIndexPath = nil;
-    while( (prevCellIndexPath = [self indexPathForCellBeforeCellAtIndexPath:currentCellIndexPath rewind:rewind])) 
+    
+    if(!_focusableIndexPaths)
+        [self rebuildFocusableRows];
+    if(!_hasUnindexedSections)
     {
-        if(!prevCellIndexPath)
+        prevCellIndexPath = [self indexPathForFocusableRowAfterIndexPath:currentCellIndexPath forward:FALSE rewind:rewind];
+        if(prevCellIndexPath)
+            prevCell = [self cellAtIndexPath:prevCellIndexPath];
+    }
+    else
+    {
+        // some sections generate their cells on demand, check each cell in turn
+        while( (prevCellIndexPath = [self indexPathForCellBeforeCellAtIndexPath:currentCellIndexPath rewind:rewind])) 
         {
-            prevCell = nil;
-            break;
-        }
+            if(!prevCellIndexPath)
+            {
+                prevCell = nil;
+                break;
+            }
         
-        prevCell = [self cellAtIndexPath:prevCellIndexPath];
-        if([prevCell canBecomeFirstResponder])
-            break;
+            prevCell = [self cellAtIndexPath:prevCellIndexPath];
+            if([prevCell canBecomeFirstResponder])
+                break;
         
-        //else
+            //else
         
-        // prevent infinite loop
-        if(prevCellIndexPath.row==self.activeCellIndexPath.row && prevCellIndexPath.section==self.activeCellIndexPath.section)
-        {
+            // prevent infinite loop
+            if(prevCellIndexPath.row==self.activeCellIndexPath.row && prevCellIndexPath.section==self.activeCellIndexPath.section)
+            {
+                prevCell = nil;
+                break;
+            }
+        
+            currentCellIndexPath = prevCellIndexPath;
             prevCell = nil;
-            break;
+            prevCellIndexPath = nil;
         }
-        
-        currentCellIndexPath = prevCellIndexPath;
-        prevCell = nil;
-        prevCellIndexPath = nil;
     }
     
     if(prevCell)
@@ -1334,6 +1467,274 @@
     }
 }
 
+- (void)setObservesBoundObjects:(BOOL)observes
+{
+    if(_observesBoundObjects == observes)
+        return;
+    
+    _observesBoundObjects = observes;
+    
+    if(observes)
+    {
+        for(UITableViewCell *cell in self.tableView.visibleCells)
+        {
+            if([cell isKindOfClass:[SCTableViewCell class]])
+                [self observeBoundObjectsForCell:(SCTableViewCell *)cell];
+        }
+    }
+    else
+    {
+        [self stopObservingAllBoundObjects];
+    }
+}
+
+- (void)observeBoundObjectsForCell:(SCTableViewCell *)cell
+{
+    [self stopObservingBoundObjectsForCell:cell];
+    
+    NSObject *object = cell.boundObject;
+    if(!object)
+        return;
+    
+    NSMutableArray *keyPaths = [NSMutableArray array];
+    for(NSString *keyPath in [cell.ownerSection observedKeyPathsForCell:cell])
+    {
+        // array element key paths (e.g. 'items[0]') can't be observed
+        if([keyPath rangeOfString:@"["].location != NSNotFound)
+            continue;
+        if(![SCUtilities resolvePropertyName:keyPath inObject:object ownerObject:NULL key:NULL resolution:NULL])
+            continue;
+        
+        [object addObserver:self forKeyPath:keyPath options:0 context:SCBoundObjectObservationContext];
+        [keyPaths addObject:keyPath];
+    }
+    if(!keyPaths.count)
+        return;
+    
+    [_cellObservations setObject:[NSArray arrayWithObjects:object, keyPaths, nil] forKey:cell];
+    
+    NSHashTable *objectCells = [_observedObjectCells objectForKey:object];
+    if(!objectCells)
+    {
+        objectCells = [NSHashTable weakObjectsHashTable];
+        [_observedObjectCells setObject:objectCells forKey:object];
+    }
+    [objectCells addObject:cell];
+}
+
+- (void)stopObservingBoundObjectsForCell:(SCTableViewCell *)cell
+{
+    NSArray *observation = [_cellObservations objectForKey:cell];
+    if(!observation)
+        return;
+    
+    NSObject *object = [observation objectAtIndex:0];
+    for(NSString *keyPath in [observation objectAtIndex:1])
+        [object removeObserver:self forKeyPath:keyPath context:SCBoundObjectObservationContext];
+    [_cellObservations removeObjectForKey:cell];
+    
+    NSHashTable *objectCells = [_observedObjectCells objectForKey:object];
+    [objectCells removeObject:cell];
+    if(!objectCells.count)
+        [_observedObjectCells removeObjectForKey:object];
+}
+
+- (void)stopObservingBoundObjectsForSection:(SCTableViewSection *)section
+{
+    for(SCTableViewCell *cell in [[_cellObservations keyEnumerator] allObjects])
+    {
+        if(cell.ownerSection != section)
+            continue;
+        
+        [self stopObservingBoundObjectsForCell:cell];
+        [_changedCells removeObject:cell];
+        [_staleCells removeObject:cell];
+    }
+}
+
+- (void)stopObservingAllBoundObjects
+{
+    for(SCTableViewCell *cell in [[_cellObservations keyEnumerator] allObjects])
+        [self stopObservingBoundObjectsForCell:cell];
+    
+    [_changedCells removeAllObjects];
+    [_staleCells removeAllObjects];
+}
+
+- (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary *)change context:(void *)context
+{
+    if(context != SCBoundObjectObservationContext)
+    {
+        [super observeValueForKeyPath:keyPath ofObject:object change:change context:context];
+        return;
+    }
+    
+    if(![NSThread isMainThread])
+    {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self observeValueForKeyPath:keyPath ofObject:object change:change context:context];
+        });
+        return;
+    }
+    
+    for(SCTableViewCell *cell in [_observedObjectCells objectForKey:object])
+        [_changedCells addObject:cell];
+    
+    // coalesce all changes made during this run loop turn
+    if(_changedCells.count && !_boundObjectsRefreshScheduled)
+    {
+        _boundObjectsRefreshScheduled = TRUE;
+        [self performSelector:@selector(refreshChangedCells) withObject:nil afterDelay:0];
+    }
+}
+
+- (void)refreshChangedCells
+{
+    _boundObjectsRefreshScheduled = FALSE;
+    
+    NSArray *changedCells = [_changedCells allObjects];
+    [_changedCells removeAllObjects];
+    
+    NSMutableArray *changedRowIndexPaths = [NSMutableArray array];
+    for(SCTableViewCell *cell in changedCells)
+    {
+        BOOL generatedRow = [cell.ownerSection isKindOfClass:[SCArrayOfItemsSection class]] && !cell.isSpecialCell;
+        
+        NSIndexPath *indexPath = [self.tableView indexPathForCell:cell];  // nil for off-screen cells
+        if(!indexPath || cell.needsCommit || cell==self.activeCell)
+        {
+            // never overwrite a value that is being edited
+            if(!generatedRow)
+                [_staleCells addObject:cell];
+            continue;
+        }
+        
+        if(generatedRow)
+            [changedRowIndexPaths addObject:indexPath];
+        else
+            [cell reloadBoundValue];
+    }
+    
+    if(changedRowIndexPaths.count)
+    {
+        [self clearLastReturnedCellData];
+        if (@available(iOS 15.0, *)) {
+            [self.tableView reconfigureRowsAtIndexPaths:changedRowIndexPaths];
+        }
+        else {
+            [self.tableView reloadRowsAtIndexPaths:changedRowIndexPaths withRowAnimation:UITableViewRowAnimationNone];
+        }
+    }
+}
+
+- (void)invalidateFocusableRows
+{
+    _focusableIndexPaths = nil;
+    _focusableRowPositions = nil;
+}
+
+- (void)rebuildFocusableRows
+{
+    _focusableIndexPaths = [NSMutableArray array];
+    _focusableRowPositions = [NSMutableDictionary dictionary];
+    _hasUnindexedSections = FALSE;
+    
+    for(NSUInteger i=0; i<sections.count; i++)
+    {
+        SCTableViewSection *section = [sections objectAtIndex:i];
+        
+        // sections that generate their cells on demand can't be indexed without instantiating every cell
+        if(section.generatesCellsOnDemand)
+        {
+            if(section.cellCount)
+                _hasUnindexedSections = TRUE;
+            continue;
+        }
+        
+        NSUInteger cellCount = section.cellCount;
+        for(NSUInteger j=0; j<cellCount; j++)
+        {
+            SCTableViewCell *cell = [section cellAtIndex:j];
+            if(![cell canBecomeFirstResponder])
+                continue;
+            
+            NSIndexPath *indexPath = [NSIndexPath indexPathForRow:j inSection:i];
+            [_focusableRowPositions setObject:@(_focusableIndexPaths.count) forKey:indexPath];
+            [_focusableIndexPaths addObject:indexPath];
+        }
+    }
+}
+
+- (NSIndexPath *)indexPathForFocusableRowAfterIndexPath:(NSIndexPath *)indexPath forward:(BOOL)forward rewind:(BOOL)rewind
+{
+    NSInteger count = _focusableIndexPaths.count;
+    if(!count)
+        return nil;
+    
+    NSInteger position;
+    NSNumber *currentPosition = indexPath ? [_focusableRowPositions objectForKey:indexPath] : nil;
+    if(currentPosition)
+    {
+        position = [currentPosition integerValue] + (forward ? 1 : -1);
+    }
+    else
+    {
+        // indexPath isn't focusable itself, find where it would be in the ordered index
+        NSInteger insertionIndex = 0;
+        if(indexPath)
+            insertionIndex = [_focusableIndexPaths indexOfObject:indexPath inSortedRange:NSMakeRange(0, count) options:NSBinarySearchingInsertionIndex usingComparator:^NSComparisonResult(NSIndexPath *indexPath1, NSIndexPath *indexPath2)
+                              {
+                                  return [indexPath1 compare:indexPath2];
+                              }];
+        position = forward ? insertionIndex : insertionIndex-1;
+    }
+    
+    // skip any cells that are no longer able to become first responder
+    for(NSInteger i=0; i<count; i++)
+    {
+        if(position<0 || position>=count)
+        {
+            if(!rewind)
+                return nil;
+            position = forward ? 0 : count-1;
+        }
+        
+        NSIndexPath *focusableIndexPath = [_focusableIndexPaths objectAtIndex:position];
+        if(indexPath && [focusableIndexPath isEqual:indexPath])
+            return nil;     // wrapped around to the current row
+        
+        SCTableViewSection *section = [self sectionAtIndex:focusableIndexPath.section];
+        if([[section cellAtIndex:focusableIndexPath.row] canBecomeFirstResponder])
+            return focusableIndexPath;
+        
+        position += forward ? 1 : -1;
+    }
+    
+    return nil;
+}
+
+- (void)updateInputAccessoryViewNavigationState
+{
+    if(!_inputAccessoryView || !self.activeCell)
+        return;
+    
+    if(!_focusableIndexPaths)
+        [self rebuildFocusableRows];
+    
+    BOOL previousEnabled = TRUE;
+    BOOL nextEnabled = TRUE;
+    // custom cells and unindexed sections might still have controls to navigate to
+    if(!_hasUnindexedSections && ![self.activeCell isKindOfClass:[SCCustomCell class]])
+    {
+        BOOL rewind = _inputAccessoryView.rewind;
+        previousEnabled = ([self indexPathForFocusableRowAfterIndexPath:self.activeCellIndexPath forward:FALSE rewind:rewind] != nil);
+        nextEnabled = ([self indexPathForFocusableRowAfterIndexPath:self.activeCellIndexPath forward:TRUE rewind:rewind] != nil);
+    }
+    
+    [_inputAccessoryView.previousNextSegmentedControl setEnabled:previousEnabled forSegmentAtIndex:0];
+    [_inputAccessoryView.previousNextSegmentedControl setEnabled:nextEnabled forSegmentAtIndex:1];
+}
+
 - (void)dismissAllDetailViewsWithCommit:(BOOL)commit
 {
     if(!self.activeDetailModel)
@@ -1361,22 +1762,145 @@
     self.activeDetailModel = nil;
 }
 
+- (void)rebuildSectionValueStates
+{
+    [_invalidSections removeAllObjects];
+    [_uncommittedSections removeAllObjects];
+    [_sweptSections removeAllObjects];
+    
+    for(SCTableViewSection *section in sections)
+    {
+        // sections that can't track their cells incrementally are swept on every access
+        if(section.sweepsCellValueStates)
+        {
+            [_sweptSections addObject:section];
+            continue;
+        }
+        
+        if(!section.valuesAreValid)
+            [_invalidSections addObject:section];
+        if(section.needsCommit)
+            [_uncommittedSections addObject:section];
+    }
+    
+    _sectionValueStatesStale = FALSE;
+    _valueIsValidActionsGeneration = [SCCellActions valueIsValidActionsGeneration];
+}
+
+- (BOOL)sectionValueStatesNeedRebuild
+{
+    return (_sectionValueStatesStale || _valueIsValidActionsGeneration!=[SCCellActions valueIsValidActionsGeneration]);
+}
+
+- (void)sectionValueStateDidChange:(SCTableViewSection *)section
+{
+    if([self sectionValueStatesNeedRebuild] || [_sweptSections containsObject:section])
+        return;     // will be recalculated on next access
+    
+    if(section.valuesAreValid)
+        [_invalidSections removeObject:section];
+    else
+        [_invalidSections addObject:section];
+    
+    if(section.needsCommit)
+        [_uncommittedSections addObject:section];
+    else
+        [_uncommittedSections removeObject:section];
+}
+
+- (void)invalidateSectionValueStates
+{
+    _sectionValueStatesStale = TRUE;
+}
+
+- (void)sectionDidSnapshotInitialCellValues:(SCTableViewSection *)section
+{
+    [_snapshotSections addObject:section];
+    
+    // Edits to user defaults stay in memory until the view controller's Done or Cancel button decides their fate
+    SCUserDefaultsStore *store = (SCUserDefaultsStore *)section.boundObjectStore;
+    if(![store isKindOfClass:[SCUserDefaultsStore class]] || store.inEditingSession)
+        return;
+    
+    UIBarButtonItem *cancelButton = nil;
+    if([self.viewController isKindOfClass:[SCTableViewController class]])
+        cancelButton = [(SCTableViewController *)self.viewController cancelButton];
+    else
+        if([self.viewController isKindOfClass:[SCViewController class]])
+            cancelButton = [(SCViewController *)self.viewController cancelButton];
+    if(cancelButton.action != @selector(cancelButtonAction))
+        return;
+    
+    [store beginEditingSession];
+    [_editingSessionStores addObject:store];
+}
+
+- (void)commitEditingSessions
+{
+    NSArray *stores = [_editingSessionStores allObjects];
+    [_editingSessionStores removeAllObjects];
+    for(SCUserDefaultsStore *store in stores)
+        [store commitEditingSession];
+}
+
+- (void)discardEditingSessions
+{
+    NSArray *stores = [_editingSessionStores allObjects];
+    [_editingSessionStores removeAllObjects];
+    for(SCUserDefaultsStore *store in stores)
+        [store discardEditingSession];
+}
+
+- (void)updateHeightForCell:(SCTableViewCell *)cell
+{
+    NSIndexPath *indexPath = [self indexPathForCell:cell];
+    if(!indexPath || !self.tableView)
+        return;
+    
+    _resizingIndexPath = indexPath;
+    [self.tableView beginUpdates];
+    [self.tableView endUpdates];
+    _resizingIndexPath = nil;
+}
+
+- (void)invalidateCellValueStates
+{
+    for(SCTableViewSection *section in sections)
+        [section invalidateCellValueStates];
+    
+    [self invalidateSectionValueStates];
+}
+
 - (BOOL)valuesAreValid
 {
-	for(SCTableViewSection *section in sections)
-		if(!section.valuesAreValid)
-			return FALSE;
+    if([self sectionValueStatesNeedRebuild])
+        [self rebuildSectionValueStates];
 	
-	return TRUE;
+	if(_invalidSections.count)
+        return FALSE;
+    //else
+    for(SCTableViewSection *section in _sweptSections)
+    {
+        if(!section.valuesAreValid)
+            return FALSE;
+    }
+    return TRUE;
 }
 
 - (BOOL)needsCommit
 {
-	for(SCTableViewSection *section in sections)
-		if(section.needsCommit)
-			return TRUE;
+    if([self sectionValueStatesNeedRebuild])
+        [self rebuildSectionValueStates];
 	
-	return FALSE;
+	if(_uncommittedSections.count)
+        return TRUE;
+    //else
+    for(SCTableViewSection *section in _sweptSections)
+    {
+        if(section.needsCommit)
+            return TRUE;
+    }
+    return FALSE;
 }
 
 - (void)commitChanges
@@ -1391,6 +1915,7 @@
 - (void)reloadBoundValues
 {
     [self clearLastReturnedCellData];
+    [_rowHeights removeAllObjects];
     
     if(self.detailViewController)
     {
@@ -1401,6 +1926,9 @@
                 [(SCTableViewController *)self.detailViewController loseFocus];
     }
     
+    // cells register their key paths again when they next appear
+    [self stopObservingAllBoundObjects];
+    
 	for(SCTableViewSection *section in sections)
 		[section reloadBoundValues];
 }
@@ -1427,9 +1955,18 @@
                 self.cellActions.willStyle(cell, indexPath);
             }
     
+    NSString *themeStyle = [self themeStyleForCell:cell atIndexPath:indexPath];
+    
+    [self.theme styleObject:cell usingThemeStyle:themeStyle onlyStylePropertyNamesInSet:propertyNames];
+}
+
+- (NSString *)themeStyleForCell:(SCTableViewCell *)cell atIndexPath:(NSIndexPath *)indexPath
+{
     NSString *themeStyle = cell.themeStyle;
     if(!themeStyle)
     {
+        SCTableViewSection *section = [self sectionAtIndex:indexPath.section];
+        
         if(indexPath.row == 0)
             themeStyle = section.firstCellThemeStyle;
         else 
@@ -1445,7 +1982,7 @@
         }
     }
     
-    [self.theme styleObject:cell usingThemeStyle:themeStyle onlyStylePropertyNamesInSet:propertyNames];
+    return themeStyle;
 }
 
 - (void)configureCell:(SCTableViewCell *)cell atIndexPath:(NSIndexPath *)indexPath
@@ -1487,6 +2024,10 @@
 {
     [self clearLastReturnedCellData];
     
+    // row counts are only requested on reloads and structural changes, after which cached heights may belong to other rows
+    if(!_resizingIndexPath)
+        [_rowHeights removeAllObjects];
+    
     return [self sectionAtIndex:section].cellCount;
 }
 
@@ -1558,9 +2099,68 @@
     }
 }
 
+#pragma mark - UITableViewDataSourcePrefetching methods
+
+- (void)tableView:(UITableView *)tableView prefetchRowsAtIndexPaths:(NSArray *)indexPaths
+{
+    NSDictionary *rowIndexes = [self rowIndexesBySectionForIndexPaths:indexPaths];
+    for(NSNumber *sectionIndex in rowIndexes)
+    {
+        SCTableViewSection *section = [self sectionAtIndex:[sectionIndex unsignedIntegerValue]];
+        [section prefetchCellsAtIndexes:[rowIndexes objectForKey:sectionIndex]];
+    }
+}
+
+- (void)tableView:(UITableView *)tableView cancelPrefetchingForRowsAtIndexPaths:(NSArray *)indexPaths
+{
+    NSDictionary *rowIndexes = [self rowIndexesBySectionForIndexPaths:indexPaths];
+    for(NSNumber *sectionIndex in rowIndexes)
+    {
+        SCTableViewSection *section = [self sectionAtIndex:[sectionIndex unsignedIntegerValue]];
+        [section cancelPrefetchingCellsAtIndexes:[rowIndexes objectForKey:sectionIndex]];
+    }
+}
+
+- (NSDictionary *)rowIndexesBySectionForIndexPaths:(NSArray *)indexPaths
+{
+    NSMutableDictionary *rowIndexes = [NSMutableDictionary dictionary];
+    for(NSIndexPath *indexPath in indexPaths)
+    {
+        if(indexPath.section >= self.sectionCount)
+            continue;
+        
+        NSNumber *sectionIndex = [NSNumber numberWithUnsignedInteger:indexPath.section];
+        NSMutableIndexSet *indexes = [rowIndexes objectForKey:sectionIndex];
+        if(!indexes)
+        {
+            indexes = [NSMutableIndexSet indexSet];
+            [rowIndexes setObject:indexes forKey:sectionIndex];
+        }
+        [indexes addIndex:indexPath.row];
+    }
+    
+    return rowIndexes;
+}
+
 #pragma mark - UITableViewDelegate methods
 
 - (CGFloat)tableView:(UITableView *)tableView heightForRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    // During a single cell resize, all other rows keep the height the table view already has
+    if(_resizingIndexPath && ![indexPath isEqual:_resizingIndexPath])
+    {
+        NSNumber *rowHeight = [_rowHeights objectForKey:indexPath];
+        if(rowHeight)
+            return [rowHeight doubleValue];
+    }
+    
+    CGFloat height = [self calculatedHeightForRowAtIndexPath:indexPath];
+    [_rowHeights setObject:@(height) forKey:indexPath];
+    
+    return height;
+}
+
+- (CGFloat)calculatedHeightForRowAtIndexPath:(NSIndexPath *)indexPath
 {
     [self clearLastReturnedCellData];
     
@@ -1728,6 +2328,16 @@
 - (void)tableView:(UITableView *)tableView willDisplayCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath
 {
 	SCTableViewCell *scCell = (SCTableViewCell *)cell;
+    [self updateModelCenterRegistration];  // the table view may have been added to a view controller's hierarchy after it was set
+    if(self.observesBoundObjects && [scCell isKindOfClass:[SCTableViewCell class]])
+    {
+        if([_staleCells containsObject:scCell] && !scCell.needsCommit)
+        {
+            [_staleCells removeObject:scCell];
+            [scCell reloadBoundValue];
+        }
+        [self observeBoundObjectsForCell:scCell];
+    }
 	[scCell willDisplay];
 	
 	// Check if the cell has an image in its section
@@ -1781,6 +2391,14 @@
     }
 }
 
+- (void)tableView:(UITableView *)tableView didEndDisplayingCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    // Generated rows are reconfigured from their items when they reappear, only persistent cells need to be marked stale
+    SCTableViewCell *scCell = (SCTableViewCell *)cell;
+    if([scCell isKindOfClass:[SCTableViewCell class]] && [scCell.ownerSection isKindOfClass:[SCArrayOfItemsSection class]] && !scCell.isSpecialCell)
+        [self stopObservingBoundObjectsForCell:scCell];
+}
+
 - (NSArray *)tableView:(UITableView *)tableView editActionsForRowAtIndexPath:(NSIndexPath *)indexPath
 {
     NSArray *editActions = nil;
@@ -2287,59 +2905,56 @@
 
 - (void)keyboardWillShow:(NSNotification *)aNotification
 {
-    if(!self.autoResizeForKeyboard || keyboardShown) 
+    if(!self.autoResizeForKeyboard) 
 		return;
 	
-	keyboardShown = YES;
-	
-    // Get the keyboard size
     UIScrollView *tableView;
     if([self.tableView.superview isKindOfClass:[UIScrollView class]])
         tableView = (UIScrollView *)self.tableView.superview;
     else
         tableView = self.tableView;
+    
+    // Get the keyboard size
     NSDictionary *userInfo = [aNotification userInfo];
     NSValue *aValue = [userInfo objectForKey:UIKeyboardFrameEndUserInfoKey];
 	CGRect keyboardRect = [tableView.superview convertRect:[aValue CGRectValue] fromView:nil];
+	
+	// Determine how much overlap exists between tableView and the keyboard (including any input accessory view)
+    CGFloat overlap = CGRectGetMaxY(tableView.frame) - keyboardRect.origin.y;
+    if (@available(iOS 11.0, *)) {
+        overlap -= tableView.safeAreaInsets.bottom;   // already part of the table view's adjusted content inset
+    }
+	if(overlap < 0)
+		overlap = 0;
+    
+    // Moving between fields re-posts the same keyboard geometry, no need to touch the table view
+    if(keyboardShown && overlap == keyboardOverlap)
+        return;
+    
+    if(!keyboardShown)
+    {
+        _contentInsetBeforeKeyboard = tableView.contentInset;
+        _scrollIndicatorInsetsBeforeKeyboard = tableView.scrollIndicatorInsets;
+    }
+	keyboardShown = YES;
+    keyboardOverlap = overlap;
     
     // Get the keyboard's animation details
     NSTimeInterval animationDuration;
 	[[userInfo objectForKey:UIKeyboardAnimationDurationUserInfoKey] getValue:&animationDuration];
 	UIViewAnimationCurve animationCurve;
 	[[userInfo objectForKey:UIKeyboardAnimationCurveUserInfoKey] getValue:&animationCurve];
-	
-	// Determine how much overlap exists between tableView and the keyboard
-    CGRect tableFrame = tableView.frame;
-    CGFloat tableLowerYCoord = tableFrame.origin.y + tableFrame.size.height;
-	keyboardOverlap = tableLowerYCoord - keyboardRect.origin.y;
-	if(self.inputAccessoryView && keyboardOverlap>0)
-    {
-        CGFloat accessoryHeight = self.inputAccessoryView.frame.size.height;
-        keyboardOverlap -= accessoryHeight;
-        
-        tableView.contentInset = UIEdgeInsetsMake(0, 0, accessoryHeight, 0);
-        tableView.scrollIndicatorInsets = UIEdgeInsetsMake(0, 0, accessoryHeight, 0);
-    }
     
-	if(keyboardOverlap < 0)
-		keyboardOverlap = 0;
-	
-	if(keyboardOverlap != 0)
-	{
-		tableFrame.size.height -= keyboardOverlap;
-		
-		NSTimeInterval delay = 0;
-		if(keyboardRect.size.height)
-		{
-			delay = (1 - keyboardOverlap/keyboardRect.size.height)*animationDuration;
-			animationDuration = animationDuration * keyboardOverlap/keyboardRect.size.height;
-		}
-		
-        [UIView animateWithDuration:animationDuration delay:delay 
-							options:UIViewAnimationOptionBeginFromCurrentState 
-						 animations:^{ tableView.frame = tableFrame; } 
-						 completion:^(BOOL finished){ [self tableAnimationEnded:nil finished:nil contextInfo:nil]; }];
-	}
+    // Adjust insets rather than the frame so that the table view's cells aren't laid out again
+    UIEdgeInsets contentInset = _contentInsetBeforeKeyboard;
+    contentInset.bottom += keyboardOverlap;
+    UIEdgeInsets scrollIndicatorInsets = _scrollIndicatorInsetsBeforeKeyboard;
+    scrollIndicatorInsets.bottom += keyboardOverlap;
+    
+    [UIView animateWithDuration:animationDuration delay:0
+                        options:UIViewAnimationOptionBeginFromCurrentState | (animationCurve << 16)
+                     animations:^{ tableView.contentInset = contentInset; tableView.scrollIndicatorInsets = scrollIndicatorInsets; }
+                     completion:^(BOOL finished){ [self tableAnimationEnded:nil finished:nil contextInfo:nil]; }];
 }
 
 - (void)keyboardWillHide:(NSNotification *)aNotification
@@ -2348,40 +2963,27 @@
 		return;
 	
 	keyboardShown = NO;
+    keyboardOverlap = 0;
     
     UIScrollView *tableView;
     if([self.tableView.superview isKindOfClass:[UIScrollView class]])
         tableView = (UIScrollView *)self.tableView.superview;
     else
         tableView = self.tableView;
-    if(self.inputAccessoryView)
-    {
-        tableView.contentInset = UIEdgeInsetsZero;
-        tableView.scrollIndicatorInsets = UIEdgeInsetsZero;
-    }
-	
-	if(keyboardOverlap == 0)
-		return;
     
-	// Get the size & animation details of the keyboard
+	// Get the keyboard's animation details
     NSDictionary *userInfo = [aNotification userInfo];
-    NSValue *aValue = [userInfo objectForKey:UIKeyboardFrameEndUserInfoKey];
-	CGRect keyboardRect = [tableView.superview convertRect:[aValue CGRectValue] fromView:nil];
-	
     NSTimeInterval animationDuration;
 	[[userInfo objectForKey:UIKeyboardAnimationDurationUserInfoKey] getValue:&animationDuration];
 	UIViewAnimationCurve animationCurve;
 	[[userInfo objectForKey:UIKeyboardAnimationCurveUserInfoKey] getValue:&animationCurve];
 	
-	CGRect tableFrame = tableView.frame; 
-	tableFrame.size.height += keyboardOverlap;
-	
-	if(keyboardRect.size.height)
-		animationDuration = animationDuration * keyboardOverlap/keyboardRect.size.height;
-	
+    UIEdgeInsets contentInset = _contentInsetBeforeKeyboard;
+    UIEdgeInsets scrollIndicatorInsets = _scrollIndicatorInsetsBeforeKeyboard;
+    
     [UIView animateWithDuration:animationDuration delay:0 
-						options:UIViewAnimationOptionBeginFromCurrentState 
-					 animations:^{ tableView.frame = tableFrame; } 
+						options:UIViewAnimationOptionBeginFromCurrentState | (animationCurve << 16)
+					 animations:^{ tableView.contentInset = contentInset; tableView.scrollIndicatorInsets = scrollIndicatorInsets; } 
 					 completion:nil];
 }
 
@@ -2407,6 +3009,13 @@
 @interface SCArrayOfItemsModel ()
 {
     NSMutableDictionary *_sectionsCellIdentifiers;
+    
+    // grouped items index, rebuilt by generateSections and maintained incrementally afterwards
+    NSMutableDictionary *_sectionsByHeaderTitle;    // header title (NSNull for nil) -> section
+    NSSet *_sectionHeaderTitlesSet;                 // titles returned by the sectionHeaderTitles action (sections kept even when empty)
+    NSMapTable *_itemPositions;                     // item -> index in the displayed items array
+    __weak NSArray *_indexedItemsArray;             // the items array _itemPositions refers to
+    BOOL _itemPositionsInSync;
 }
 
 #if __IPHONE_OS_VERSION_MIN_REQUIRED >= __IPHONE_8_0
@@ -2423,8 +3032,16 @@
 
 - (void)addNewItemToRespectiveSection:(NSObject *)newItem;
 
+- (SCArrayOfItemsSection *)groupedSectionWithHeaderTitle:(NSString *)headerTitle;
+- (void)setGroupedSection:(SCArrayOfItemsSection *)section forHeaderTitle:(NSString *)headerTitle;
+- (BOOL)keepsEmptySection:(SCArrayOfItemsSection *)section;
+- (NSUInteger)indexOfGroupedItem:(NSObject *)item;
+
 - (NSString *)safeSearchStringFromString:(NSString *)searchString;
 
+- (BOOL)itemPassesDataFetchFilter:(NSObject *)item;
+- (void)dataStoreDidChangeObjects:(NSNotification *)notification;
+
 @end
 
 
@@ -2477,6 +3094,12 @@
         newItemDetailViewControllerOptions = nil;
         
         _sectionsCellIdentifiers = [NSMutableDictionary dictionary];
+        
+        _sectionsByHeaderTitle = [NSMutableDictionary dictionary];
+        _sectionHeaderTitlesSet = nil;
+        _itemPositions = [NSMapTable mapTableWithKeyOptions:(NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality) valueOptions:NSPointerFunctionsStrongMemory];
+        _indexedItemsArray = nil;
+        _itemPositionsInSync = FALSE;
 	}
 	
 	return self;
@@ -2507,8 +3130,13 @@
 
 - (void)setDataStore:(SCDataStore *)__dataStore
 {
+    [[NSNotificationCenter defaultCenter] removeObserver:self name:SCDataStoreDidChangeObjectsNotification object:dataStore];
+    
     dataStore =  __dataStore;
     
+    // The model's sections leave store changes to the model, since the model owns the items they display
+    [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(dataStoreDidChangeObjects:) name:SCDataStoreDidChangeObjectsNotification object:dataStore];
+    
     if(!dataFetchOptions)
         dataFetchOptions = [__dataStore.defaultDataDefinition generateCompatibleDataFetchOptions];
     
@@ -2636,6 +3264,8 @@
 - (void)generateSections
 {
 	[self removeAllSections];
+    [_sectionsByHeaderTitle removeAllObjects];
+    [_itemPositions removeAllObjects];
 	
 	NSArray *itemsArray;
 	if(filteredArray)
@@ -2644,17 +3274,22 @@
 		itemsArray = self.items;
 	
     NSArray *sectionHeaderTitles = [self getSectionHeaderTitles];
+    _sectionHeaderTitlesSet = sectionHeaderTitles ? [NSSet setWithArray:sectionHeaderTitles] : nil;
     for(NSString *sectionHeaderTitle in sectionHeaderTitles)
     {
         SCArrayOfItemsSection *section = [self createSectionWithHeaderTitle:sectionHeaderTitle];
         [self setPropertiesForSection:section];
         [self addSection:section];
+        [self setGroupedSection:section forHeaderTitle:sectionHeaderTitle];
     }
     
     for(NSUInteger i=0; i<itemsArray.count; i++)
 	{
+        NSObject *item = [itemsArray objectAtIndex:i];
+        [_itemPositions setObject:[NSNumber numberWithUnsignedInteger:i] forKey:item];
+        
 		NSString *headerTitle = [self getHeaderTitleForItemAtIndex:i];
-		SCArrayOfItemsSection *section = (SCArrayOfItemsSection *)[self sectionWithHeaderTitle:headerTitle];
+		SCArrayOfItemsSection *section = [self groupedSectionWithHeaderTitle:headerTitle];
 		if(!section)
 		{
 			section = [self createSectionWithHeaderTitle:headerTitle];
@@ -2673,9 +3308,12 @@
             
 			[self setPropertiesForSection:section];
 			[self addSection:section];
+            [self setGroupedSection:section forHeaderTitle:headerTitle];
 		}
-		[[section mutableItems] addObject:[itemsArray objectAtIndex:i]];
+		[[section mutableItems] addObject:item];
 	}
+    _indexedItemsArray = itemsArray;
+    _itemPositionsInSync = TRUE;
     
     for(SCArrayOfItemsSection *section in sections)
     {
@@ -2726,27 +3364,78 @@
 
 - (NSUInteger)getSectionIndexForItem:(NSObject *)item
 {
-    NSArray *itemsArray;
-	if(filteredArray)
-		itemsArray = filteredArray;
-	else
-		itemsArray = self.items;
-    
-	NSUInteger itemIndex = [itemsArray indexOfObjectIdenticalTo:item];
+	NSUInteger itemIndex = [self indexOfGroupedItem:item];
 	NSString *sectionHeader = [self getHeaderTitleForItemAtIndex:itemIndex];
 	
     if(!sectionHeader)
         return 0;
 	
-	NSUInteger sectionIndex = NSNotFound;
-	for(NSUInteger i=0; i<self.sectionCount; i++)
-		if([[self sectionAtIndex:i].headerTitle isEqualToString:sectionHeader])
-		   {
-			   sectionIndex = i;
-			   break;
-		   }
+    SCArrayOfItemsSection *section = [self groupedSectionWithHeaderTitle:sectionHeader];
+    if(!section)
+        return NSNotFound;
 	 
-	return sectionIndex;
+	return [self indexForSection:section];
+}
+
+- (SCArrayOfItemsSection *)groupedSectionWithHeaderTitle:(NSString *)headerTitle
+{
+    id key = headerTitle ? headerTitle : [NSNull null];
+    SCArrayOfItemsSection *section = [_sectionsByHeaderTitle objectForKey:key];
+    if(section && section.ownerTableViewModel==self)
+        return section;
+    
+    // the section was removed or added outside the index, fall back to a scan
+    section = (SCArrayOfItemsSection *)[self sectionWithHeaderTitle:headerTitle];
+    [self setGroupedSection:section forHeaderTitle:headerTitle];
+    
+    return section;
+}
+
+- (void)setGroupedSection:(SCArrayOfItemsSection *)section forHeaderTitle:(NSString *)headerTitle
+{
+    id key = headerTitle ? headerTitle : [NSNull null];
+    if(section)
+        [_sectionsByHeaderTitle setObject:section forKey:key];
+    else
+        [_sectionsByHeaderTitle removeObjectForKey:key];
+}
+
+- (BOOL)keepsEmptySection:(SCArrayOfItemsSection *)section
+{
+    return section.headerTitle && [_sectionHeaderTitlesSet containsObject:section.headerTitle];
+}
+
+- (NSUInteger)indexOfGroupedItem:(NSObject *)item
+{
+    NSArray *itemsArray;
+	if(filteredArray)
+		itemsArray = filteredArray;
+	else
+		itemsArray = self.items;
+    
+    if(itemsArray != _indexedItemsArray)
+        _itemPositionsInSync = FALSE;
+    
+    NSNumber *position = [_itemPositions objectForKey:item];
+    if(position)
+    {
+        NSUInteger index = [position unsignedIntegerValue];
+        if(index<itemsArray.count && [itemsArray objectAtIndex:index]==item)
+            return index;
+    }
+    else
+        if(_itemPositionsInSync)
+            return NSNotFound;
+    
+    // positions shifted after a removal (or the items array changed), re-index them all in a single pass
+    [_itemPositions removeAllObjects];
+    for(NSUInteger i=0; i<itemsArray.count; i++)
+        [_itemPositions setObject:[NSNumber numberWithUnsignedInteger:i] forKey:[itemsArray objectAtIndex:i]];
+    _indexedItemsArray = itemsArray;
+    _itemPositionsInSync = TRUE;
+    
+    position = [_itemPositions objectForKey:item];
+    return position ? [position unsignedIntegerValue] : NSNotFound;
 }
 
 - (SCArrayOfItemsSection *)createSectionWithHeaderTitle:(NSString *)title
@@ -2990,6 +3679,8 @@
             [self.dataStore insertObject:newItem];
             
             [items addObject:newItem];
+            if(!filteredArray)
+                [_itemPositions setObject:[NSNumber numberWithUnsignedInteger:items.count-1] forKey:newItem];
             [self addNewItemToRespectiveSection:newItem];
             break;
             
@@ -2998,6 +3689,8 @@
                     success:^()
                     {
                         [self->items addObject:newItem];  // dgApps added the self-> to avoid a warning: "Block implicitly retains 'self'; explicitly mention 'self' to indicate this is intended behavior"
+                        if(!self->filteredArray)
+                            [self->_itemPositions setObject:[NSNumber numberWithUnsignedInteger:self->items.count-1] forKey:newItem];
                         [self addNewItemToRespectiveSection:newItem];
                     }
                     failure:^(NSError *error)
@@ -3014,16 +3707,17 @@
 
 - (void)addNewItemToRespectiveSection:(NSObject *)newItem
 {
-    NSUInteger itemIndex = [self.items indexOfObjectIdenticalTo:newItem];
+    NSUInteger itemIndex = [self indexOfGroupedItem:newItem];
 	
 	NSString *headerTitle = [self getHeaderTitleForItemAtIndex:itemIndex];
-	SCArrayOfItemsSection *section = (SCArrayOfItemsSection *)[self sectionWithHeaderTitle:headerTitle];
+	SCArrayOfItemsSection *section = [self groupedSectionWithHeaderTitle:headerTitle];
 	if(!section)
 	{
 		// Add new section
 		section = [self createSectionWithHeaderTitle:headerTitle];
 		[self setPropertiesForSection:section];
 		[self addSection:section];
+        [self setGroupedSection:section forHeaderTitle:headerTitle];
 		NSUInteger sectionIndex = [self indexForSection:section];
 		
 		[self.tableView insertSections:[NSIndexSet indexSetWithIndex:sectionIndex] 
@@ -3034,9 +3728,10 @@
 		}
 	}
 	
-    [[section mutableItems] addObject:newItem];
     if(section.dataFetchOptions.sort)
-        [section.dataFetchOptions sortMutableArray:[section mutableItems]];
+        [section.dataFetchOptions insertObject:newItem inSortedMutableArray:[section mutableItems]];
+    else
+        [[section mutableItems] addObject:newItem];
 	[section addCellForNewItem:newItem];
 }
 
@@ -3066,8 +3761,7 @@
                                inSection:oldSectionIndex];
             [[section mutableItems] removeObjectAtIndex:oldIndexPath.row];
             section.selectedCellIndexPath = nil;
-            NSArray *sectionHeaderTitles = [self getSectionHeaderTitles];
-            if( [section mutableItems].count || (sectionHeaderTitles && [sectionHeaderTitles indexOfObject:section.headerTitle]!=NSNotFound) )
+            if( [section mutableItems].count || [self keepsEmptySection:section] )
             {
                 self.activeCell = nil;
                 [self.tableView deleteRowsAtIndexPaths:[NSArray arrayWithObject:oldIndexPath] withRowAnimation:UITableViewRowAnimationRight];
@@ -3085,6 +3779,7 @@
                 self.activeCell = nil;
                 [self removeSectionAtIndex:oldSectionIndex];
                 section.ownerTableViewModel = nil;
+                [self setGroupedSection:nil forHeaderTitle:section.headerTitle];
                 
                 [self.tableView deleteSections:[NSIndexSet indexSetWithIndex:oldSectionIndex]
                               withRowAnimation:UITableViewRowAnimationRight];
@@ -3098,7 +3793,15 @@
 
 - (void)itemRemoved:(NSObject *)item inSection:(SCArrayOfItemsSection *)section
 {
-    [(NSMutableArray *)self.items removeObjectIdenticalTo:item];
+    NSUInteger itemIndex = filteredArray ? NSNotFound : [self indexOfGroupedItem:item];
+    if(itemIndex != NSNotFound)
+    {
+        [items removeObjectAtIndex:itemIndex];
+        [_itemPositions removeObjectForKey:item];
+        _itemPositionsInSync = FALSE;  // positions after itemIndex are re-indexed lazily
+    }
+    else
+        [(NSMutableArray *)self.items removeObjectIdenticalTo:item];
 }
 
 - (void)invalidateItems
@@ -3107,6 +3810,93 @@
     sectionsInSync = FALSE;
 }
 
+- (BOOL)itemPassesDataFetchFilter:(NSObject *)item
+{
+    if(!self.dataFetchOptions.filter || !self.dataFetchOptions.filterPredicate)
+        return TRUE;
+    //else
+    return [[[NSArray arrayWithObject:item] filteredArrayUsingPredicate:self.dataFetchOptions.filterPredicate] count] > 0;
+}
+
+- (void)dataStoreDidChangeObjects:(NSNotification *)notification
+{
+    // Items that have not been fetched yet will be fetched fresh on next access anyway
+    if(!itemsInSync || _loadingContents)
+        return;
+    
+    if([notification.userInfo objectForKey:SCDataStoreInvalidatedAllObjectsKey] || self.dataFetchOptions.batchSize)
+    {
+        // changes cannot be applied incrementally (new objects might belong to batches that have not been fetched yet)
+        [self reloadBoundValues];
+        [self.tableView reloadData];
+        return;
+    }
+    
+    NSArray *insertedObjects = [notification.userInfo objectForKey:SCDataStoreInsertedObjectsKey];
+    NSArray *updatedObjects = [notification.userInfo objectForKey:SCDataStoreUpdatedObjectsKey];
+    NSArray *deletedObjects = [notification.userInfo objectForKey:SCDataStoreDeletedObjectsKey];
+    
+    // only the changed objects are evaluated against the model's fetch options
+    NSArray *oldItems = [NSArray arrayWithArray:items];
+    for(NSObject *object in deletedObjects)
+        [items removeObjectIdenticalTo:object];
+    NSMutableArray *changedItems = [NSMutableArray array];
+    for(NSObject *object in [insertedObjects arrayByAddingObjectsFromArray:updatedObjects])
+    {
+        BOOL exists = [items indexOfObjectIdenticalTo:object] != NSNotFound;
+        BOOL passes = [self itemPassesDataFetchFilter:object];
+        
+        if(passes && !exists)
+            [items addObject:object];
+        else if(!passes && exists)
+            [items removeObjectIdenticalTo:object];
+        else if(passes)
+            [changedItems addObject:object];
+    }
+    if(self.dataFetchOptions.sort)
+        [self.dataFetchOptions sortMutableArray:items];
+    _itemPositionsInSync = FALSE;
+    
+    [self clearLastReturnedCellData];
+    if(!filteredArray && [oldItems isEqualToArray:items])
+    {
+        if(!changedItems.count)
+            return;
+        
+        // items kept their order, so unless one of them changed its section header title only its row needs refreshing
+        NSMutableArray *changedIndexPaths = [NSMutableArray arrayWithCapacity:changedItems.count];
+        for(NSObject *item in changedItems)
+        {
+            NSUInteger sectionIndex = [self getSectionIndexForItem:item];
+            SCArrayOfItemsSection *section = sectionIndex<self.sectionCount ? (SCArrayOfItemsSection *)[self sectionAtIndex:sectionIndex] : nil;
+            NSUInteger row = [section isKindOfClass:[SCArrayOfItemsSection class]] ? [[section mutableItems] indexOfObjectIdenticalTo:item] : NSNotFound;
+            if(row == NSNotFound)
+            {
+                [changedIndexPaths removeAllObjects];
+                break;
+            }
+            [changedIndexPaths addObject:[NSIndexPath indexPathForRow:row inSection:sectionIndex]];
+            
+            // drops any texts prefetched for the item's old values
+            [section cancelPrefetchingCellsAtIndexes:[NSIndexSet indexSetWithIndex:row]];
+        }
+        if(changedIndexPaths.count)
+        {
+            [self.tableView reloadRowsAtIndexPaths:changedIndexPaths withRowAnimation:UITableViewRowAnimationNone];
+            return;
+        }
+    }
+    
+    // regroup the changed items without refetching
+    if(filteredArray)
+        [self searchBar:self.searchBar textDidChange:self.searchBar.text];
+    else
+    {
+        [self generateSections];
+        [self.tableView reloadData];
+    }
+}
+
 
 // Overrides superclass
 - (NSInteger)numberOfSectionsInTableView:(UITableView *)tableView
@@ -3129,10 +3919,10 @@
 	[super tableView:tableView commitEditingStyle:editingStyle forRowAtIndexPath:indexPath];
 	
 	// Remove the section if empty
-	NSArray *sectionHeaderTitles = [self getSectionHeaderTitles];
-    if(![section mutableItems].count && (!sectionHeaderTitles || [sectionHeaderTitles indexOfObject:section.headerTitle]==NSNotFound) )
+    if(![section mutableItems].count && ![self keepsEmptySection:section] )
 	{
 		[self removeSectionAtIndex:indexPath.section];
+        [self setGroupedSection:nil forHeaderTitle:section.headerTitle];
 		[self.tableView deleteSections:[NSIndexSet indexSetWithIndex:indexPath.section]
 							 withRowAnimation:UITableViewRowAnimationRight];
 		if(self.autoGenerateSectionIndexTitles)
@@ -224,6 +224,11 @@
 /** Overrides optimization and sets all cells as needing to be committed. */
 - (void)invalidateCellCommits;
 
+/** 
+ The section keeps track of its invalid and uncommitted cells incrementally as their values change. Call this method to force a full re-validation of all the section's cells in case a cell's validity depends on something other than its own value. 
+ */
+- (void)invalidateCellValueStates;
+
 /** Reload's the section's bound values in case the associated bound objects or keys valuea has changed by means other than the cells themselves (e.g. external custom code). */
 - (void)reloadBoundValues;
 
@@ -273,6 +278,33 @@
 /** Called internally to rollback to initial cell bound values when their bound object was first assigned. */
 - (void)rollbackToInitialCellValues;
 
+/** Returns TRUE if the section is able to incrementally track its cells' validity and commit states. Subclasses that don't manage their cells through addCell:/insertCell:/removeCellAtIndex: should return FALSE. Default: TRUE. */
+@property (nonatomic, readonly) BOOL tracksCellValueStates;
+
+/** Returns TRUE if the section creates its cells on demand from its items rather than holding them, in which case its cells can't be enumerated without instantiating each one. Default: FALSE. Method called internally. */
+@property (nonatomic, readonly) BOOL generatesCellsOnDemand;
+
+/** Returns TRUE if the section re-validates all its cells on every valuesAreValid and needsCommit access. This is the case when tracksCellValueStates is FALSE, or when a valueIsValid action is assigned to the model, the section or any of its cells, since custom validation may depend on other cells. Method called internally. */
+@property (nonatomic, readonly) BOOL sweepsCellValueStates;
+
+/** Method called internally by cells whenever their valueIsValid or needsCommit state might have changed. */
+- (void)cellValueStateDidChange:(SCTableViewCell *)cell;
+
+/** Method called internally by cells the first time their bound value is changed after binding, so that rollbackToInitialCellValues only needs to restore edited cells. */
+- (void)cellDidSnapshotInitialBoundValue:(SCTableViewCell *)cell;
+
+/** Returns TRUE if any of the section's cells have changed their bound values since binding. Method called internally. */
+@property (nonatomic, readonly) BOOL hasInitialCellValueSnapshots;
+
+/** Returns the key paths of the cell's bound object that the section displays in the given cell. Method called internally by the owner model when its observesBoundObjects property is TRUE. */
+- (NSArray *)observedKeyPathsForCell:(SCTableViewCell *)cell;
+
+/** Method called internally by the owner model when the rows at the given indexes are likely to be displayed soon. Sections that generate their cells on demand should override this method to load the rows' data ahead of time. Default implementation does nothing. */
+- (void)prefetchCellsAtIndexes:(NSIndexSet *)indexes;
+
+/** Method called internally by the owner model when rows passed to prefetchCellsAtIndexes: are no longer likely to be displayed. Any pending work for these rows should be cancelled. */
+- (void)cancelPrefetchingCellsAtIndexes:(NSIndexSet *)indexes;
+
 @end
 
 
@@ -523,6 +555,11 @@
 /** This property is TRUE when the section is in a state of fetching its items from their dataStore. */
 @property (nonatomic, readonly) BOOL isFetchingItems;
 
+/** The total number of items in dataStore that satisfy dataFetchOptions, as counted by the store when the first batch is fetched. Can be used to size scroll indicators or display a total when dataFetchOptions specifies a batchSize. Equals NSNotFound when dataFetchOptions has no batchSize or the store can't count its objects, in which case fetchItemsCell is displayed whenever the last fetched batch was full.
+ @see [SCDataStore countObjectsWithOptions:]
+ */
+@property (nonatomic, readonly) NSUInteger itemsTotalCount;
+
 /** The accessory type of the generated cells. */
 @property (nonatomic, readwrite) UITableViewCellAccessoryType itemsAccessoryType;
 
@@ -610,6 +647,10 @@
 /** User can call this method to dispatch a RemoveRow event, the same event dispached when the end-user taps the delete button on a cell. */
 - (void)dispatchEventRemoveRowAtIndexPath:(NSIndexPath *)indexPath;
 
+/** Call this method to have the section prepare a reusable detail view controller for its first item as soon as the main run loop is idle, so that the first detail view gets presented faster.
+ @note: Only applicable if detailViewControllerOptions.reuseDetailViewControllers is TRUE. */
+- (void)prewarmDetailViewController;
+
 //////////////////////////////////////////////////////////////////////////////////////////
 /// @name Internal Properties & Methods (should only be used by the framework or when subclassing)
 //////////////////////////////////////////////////////////////////////////////////////////
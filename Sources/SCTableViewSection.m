@@ -19,9 +19,20 @@
 
 
 @interface SCTableViewSection ()
+{
+    NSHashTable *_invalidCells;         // cells whose valueIsValid is FALSE
+    NSHashTable *_uncommittedCells;     // cells whose needsCommit is TRUE
+    BOOL _cellValueStatesStale;
+    NSUInteger _valueIsValidActionsGeneration;  // [SCCellActions valueIsValidActionsGeneration] the states were built with
+    
+    NSHashTable *_snapshotCells;        // cells holding an initial bound value snapshot (edited since binding)
+}
 
 @property (nonatomic, strong) NSMutableArray *cells;
 
+- (void)rebuildCellValueStates;
+- (BOOL)cellValueStatesNeedRebuild;
+
 @end
 
 
@@ -84,6 +95,11 @@
 		cellsImageViews = nil;
 		cellActions = [[SCCellActions alloc] init];
 		cells = [[NSMutableArray alloc] init];
+        _invalidCells = [NSHashTable weakObjectsHashTable];
+        _uncommittedCells = [NSHashTable weakObjectsHashTable];
+        _cellValueStatesStale = TRUE;
+        _valueIsValidActionsGeneration = 0;
+        _snapshotCells = [NSHashTable weakObjectsHashTable];
         
         expandCollapseCell = nil;
         
@@ -125,6 +141,11 @@
     
     for(SCTableViewCell *cell in self.cells)
         cell.ownerTableViewModel = _ownerTableViewModel;
+    
+    [self invalidateCellValueStates];
+    
+    if(_snapshotCells.count)
+        [_ownerTableViewModel sectionDidSnapshotInitialCellValues:self];
 }
 
 - (void)setExpandCollapseCell:(SCExpandCollapseCell *)cell
@@ -255,6 +276,9 @@
     cell.ownerSection = self;
 	cell.commitChangesLive = self.commitCellChangesLive;
 	[self.cells addObject:cell];
+    
+    [self invalidateCellValueStates];
+    [self.ownerTableViewModel invalidateFocusableRows];
 }
 
 - (void)insertCell:(SCTableViewCell *)cell atIndex:(NSUInteger)index
@@ -263,6 +287,9 @@
     cell.ownerSection = self;
 	cell.commitChangesLive = self.commitCellChangesLive;
 	[self.cells insertObject:cell atIndex:index];
+    
+    [self invalidateCellValueStates];
+    [self.ownerTableViewModel invalidateFocusableRows];
 }
 
 - (SCTableViewCell *)cellAtIndex:(NSUInteger)index
@@ -285,6 +312,15 @@
     }
 	
 	[self.cells removeObjectAtIndex:index];
+    [self.ownerTableViewModel invalidateFocusableRows];
+    
+    if([_invalidCells containsObject:cell] || [_uncommittedCells containsObject:cell])
+    {
+        [_invalidCells removeObject:cell];
+        [_uncommittedCells removeObject:cell];
+        [self.ownerTableViewModel sectionValueStateDidChange:self];
+    }
+    [_snapshotCells removeObject:cell];
 }
 
 - (void)removeCellIdenticalTo:(SCTableViewCell *)cell
@@ -298,6 +334,10 @@
 - (void)removeAllCells
 {
     [self.cells removeAllObjects];
+    [_snapshotCells removeAllObjects];
+    
+    [self invalidateCellValueStates];
+    [self.ownerTableViewModel invalidateFocusableRows];
 }
 
 - (NSUInteger)indexForCell:(SCTableViewCell *)cell
@@ -305,40 +345,136 @@
 	return [self.cells indexOfObjectIdenticalTo:cell];
 }
 
-- (BOOL)valuesAreValid
+- (BOOL)tracksCellValueStates
 {
+    return TRUE;
+}
+
+- (BOOL)generatesCellsOnDemand
+{
+    return FALSE;
+}
+
+- (void)rebuildCellValueStates
+{
+    [_invalidCells removeAllObjects];
+    [_uncommittedCells removeAllObjects];
+    
+    BOOL hasValueIsValidActions = (self.ownerTableViewModel.cellActions.valueIsValid || self.cellActions.valueIsValid);
 	for(SCTableViewCell *cell in self.cells)
     {
         if([cell isKindOfClass:[SCTableViewCell class]])
         {
             if(!cell.valueIsValid)
-                return FALSE;
+                [_invalidCells addObject:cell];
+            if(cell.needsCommit)
+                [_uncommittedCells addObject:cell];
+            
+            if(cell.cellActions.valueIsValid)
+                hasValueIsValidActions = TRUE;
         }
     }
-	
-	return TRUE;
+    
+    // custom validation may depend on other cells, so it can't be tracked incrementally
+    _cellValueStatesStale = !self.tracksCellValueStates || hasValueIsValidActions;
+    _valueIsValidActionsGeneration = [SCCellActions valueIsValidActionsGeneration];
 }
 
-- (BOOL)needsCommit
+- (BOOL)cellValueStatesNeedRebuild
 {
-	for(SCTableViewCell *cell in self.cells)
+    return (_cellValueStatesStale || _valueIsValidActionsGeneration!=[SCCellActions valueIsValidActionsGeneration]);
+}
+
+- (BOOL)sweepsCellValueStates
+{
+    if([self cellValueStatesNeedRebuild])
+        [self rebuildCellValueStates];
+    
+    return _cellValueStatesStale;
+}
+
+- (void)invalidateCellValueStates
+{
+    _cellValueStatesStale = TRUE;
+    
+    [self.ownerTableViewModel invalidateSectionValueStates];
+}
+
+- (void)cellValueStateDidChange:(SCTableViewCell *)cell
+{
+    if(![self cellValueStatesNeedRebuild])
     {
-        if([cell isKindOfClass:[SCTableViewCell class]])
-        {
-            if(cell.needsCommit)
-                return TRUE;
-        }
+        if(cell.valueIsValid)
+            [_invalidCells removeObject:cell];
+        else
+            [_invalidCells addObject:cell];
+        
+        if(cell.needsCommit)
+            [_uncommittedCells addObject:cell];
+        else
+            [_uncommittedCells removeObject:cell];
     }
+    
+    [self.ownerTableViewModel sectionValueStateDidChange:self];
+}
+
+- (void)cellDidSnapshotInitialBoundValue:(SCTableViewCell *)cell
+{
+    [_snapshotCells addObject:cell];
+    
+    [self.ownerTableViewModel sectionDidSnapshotInitialCellValues:self];
+}
+
+- (BOOL)hasInitialCellValueSnapshots
+{
+    return (_snapshotCells.count > 0);
+}
+
+- (NSArray *)observedKeyPathsForCell:(SCTableViewCell *)cell
+{
+    return [cell observedBoundKeyPaths];
+}
+
+- (void)prefetchCellsAtIndexes:(NSIndexSet *)indexes
+{
+    // Does nothing, cells already exist. Should be overridden by subclasses that generate their cells.
+}
+
+- (void)cancelPrefetchingCellsAtIndexes:(NSIndexSet *)indexes
+{
+    // Does nothing, should be overridden by subclasses
+}
+
+- (BOOL)valuesAreValid
+{
+    if([self cellValueStatesNeedRebuild])
+        [self rebuildCellValueStates];
+	
+	return (_invalidCells.count == 0);
+}
+
+- (BOOL)needsCommit
+{
+    if([self cellValueStatesNeedRebuild])
+        [self rebuildCellValueStates];
 	
-	return FALSE;
+	return (_uncommittedCells.count > 0);
 }
 
 - (void)commitCellChanges
 {
+    // Only visit cells with pending changes when they're being tracked
+    BOOL onlyUncommittedCells = !_cellValueStatesStale;
+    if(onlyUncommittedCells && !_uncommittedCells.count)
+        return;
+    
 	for(SCTableViewCell *cell in self.cells)
     {
         if([cell isKindOfClass:[SCTableViewCell class]])
         {
+            if(onlyUncommittedCells && ![_uncommittedCells containsObject:cell])
+                continue;
+            
             [cell commitChanges];
         }
     }
@@ -364,6 +500,8 @@
             [cell reloadBoundValue];
         }
     }
+    
+    [self invalidateCellValueStates];
 }
 
 - (CGFloat)heightForCellAtIndexPath:(NSIndexPath *)indexPath
@@ -407,6 +545,8 @@
     if(self.cells.count < 2)
         return;
     
+    [self.ownerTableViewModel invalidateFocusableRows];
+    
     if(self.ownerTableViewModel.live)
     {
         NSUInteger sectionIndex = [self.ownerTableViewModel indexForSection:self];
@@ -440,13 +580,18 @@
         return;
     
     
-    for(SCTableViewCell *cell in self.cells)
+    if(!_snapshotCells.count)
+        return;     // no cell values have changed since binding
+    
+    // Only cells that snapshotted their initial value on first write need to be restored
+    NSArray *snapshotCells = [_snapshotCells allObjects];
+    [_snapshotCells removeAllObjects];
+    for(SCTableViewCell *cell in snapshotCells)
     {
-        if([cell isKindOfClass:[SCTableViewCell class]])
-        {
-            [cell rollbackToInitialBoundValue];
-        }
+        [cell rollbackToInitialBoundValue];
     }
+    
+    [self invalidateCellValueStates];
 }
 
 
@@ -1174,14 +1319,34 @@
 @interface SCArrayOfItemsSection ()
 {
     NSIndexPath *_backedUpSelectedCellIndexPath;
+    
+    NSMapTable *_detailViewControllerPool;  // item data definition (weak) -> reusable detail view controllers keyed by detailViewControllerPoolKeyForItem:newItem:
+    
+    NSMapTable *_prefetchedCellTexts;   // item -> [text, detail text] resolved by prefetchCellsAtIndexes:
+    NSArray *_imagePropertyNames;       // item properties bound to image views in generated custom cells
+    
+    NSMutableDictionary *_prototypeCells;           // reuse identifier -> offscreen cell used to measure row heights
+    NSMutableDictionary *_prototypeAssignedHeights; // reuse identifier -> the prototype's height before any row styled it
+    NSMutableDictionary *_prototypeStyledHeights;   // reuse identifier|theme style -> height assigned by the theme
+    BOOL _bindingPrototypeCell;                     // TRUE while a prototype is bound to a row, prefetched texts are kept for the row's real cell
+    
+    NSUInteger _itemsTotalCount;        // number of items in dataStore for dataFetchOptions, NSNotFound if unknown
+    NSUInteger _fetchedItemsCount;      // number of store items up to the end of the last fetched batch
+    NSUInteger _itemsCountGeneration;   // identifies the latest asynchronous count request
 }
 
 @property (nonatomic, strong) NSMutableArray *mutableItems;
+@property (nonatomic, readwrite) BOOL buildingPrewarmedDetailModel;
 
 - (void)setActiveDetailModel:(SCTableViewModel *)model;
 
 - (SCTableViewCell *)unconfiguredCellAtIndex:(NSUInteger)index;
+- (NSString *)reuseIdentifierForCellAtIndexPath:(NSIndexPath *)indexPath;
+- (BOOL)rowIsAboutToBeDisplayedAtIndexPath:(NSIndexPath *)indexPath;
+- (SCTableViewCell *)prototypeCellWithReuseIdentifier:(NSString *)cellId atIndexPath:(NSIndexPath *)indexPath;
+- (CGFloat)prototypeHeightForCellAtIndexPath:(NSIndexPath *)indexPath;
 - (BOOL)fetchItemsCellExists;
+- (void)removeFetchItemsCellIfNoMoreItems;
 - (BOOL)addNewItemCellExists;
 - (BOOL)addNewItemCellExistsForEditingMode:(BOOL)editing;
 
@@ -1189,6 +1354,11 @@
 - (BOOL)isViewControllerActive:(UIViewController *)viewController;
 - (UIViewController *)getDetailViewControllerForCell:(SCTableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath withItem:(NSObject *)item;
 - (SCTableViewModel *)getCustomDetailModelForRowAtIndexPath:(NSIndexPath *)indexPath;
+- (NSMutableDictionary *)detailViewControllerPoolForItem:(NSObject *)item;
+- (NSString *)detailViewControllerPoolKeyForItem:(NSObject *)item newItem:(BOOL)newItem;
+- (BOOL)canRebindDetailModel:(SCTableViewModel *)detailModel;
+- (SCTableViewController *)dequeueReusableDetailViewControllerForItem:(NSObject *)item newItem:(BOOL)newItem;
+- (void)generatePrewarmedDetailViewController;
 - (void)presentDetailViewController:(UIViewController *)detailViewController forCell:(SCTableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath withPresentationMode:(SCPresentationMode)mode;
 
 
@@ -1200,6 +1370,9 @@
 - (void)discardTempItem;
 
 - (void)dataStoreWillDiscardUninsertedObjects;
+- (void)dataStoreDidChangeObjects:(NSNotification *)notification;
+
+- (NSArray *)imageURLsForItem:(NSObject *)item;
 
 - (void)handleDetailViewControllerDidLoad:(UIViewController *)detailViewController;
 - (void)handleDetailViewControllerWillPresent:(UIViewController *)detailViewController;
@@ -1225,6 +1398,7 @@
 @synthesize dataFetchOptions;
 @synthesize autoFetchItems;
 @synthesize isFetchingItems = _isFetchingItems;
+@synthesize itemsTotalCount = _itemsTotalCount;
 @synthesize itemsAccessoryType;
 @synthesize allowAddingItems;
 @synthesize allowDeletingItems;
@@ -1286,6 +1460,17 @@
         addNewItemCell = nil;
         addNewItemCellExistsInNormalMode = TRUE;
         addNewItemCellExistsInEditingMode = TRUE;
+        
+        _prefetchedCellTexts = [NSMapTable mapTableWithKeyOptions:(NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality) valueOptions:NSPointerFunctionsStrongMemory];
+        _imagePropertyNames = nil;
+        
+        _prototypeCells = [NSMutableDictionary dictionary];
+        _prototypeAssignedHeights = [NSMutableDictionary dictionary];
+        
+        _itemsTotalCount = NSNotFound;
+        _fetchedItemsCount = 0;
+        _itemsCountGeneration = 0;
+        _prototypeStyledHeights = [NSMutableDictionary dictionary];
 	}
 	
 	return self;
@@ -1334,10 +1519,12 @@
 - (void)setDataStore:(SCDataStore *)__dataStore
 {
     [[NSNotificationCenter defaultCenter] removeObserver:self name:SCDataStoreWillDiscardAllUninsertedObjectsNotification object:dataStore];
+    [[NSNotificationCenter defaultCenter] removeObserver:self name:SCDataStoreDidChangeObjectsNotification object:dataStore];
     
     dataStore = __dataStore;
     // Register with store notifications
     [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(dataStoreWillDiscardUninsertedObjects) name:SCDataStoreWillDiscardAllUninsertedObjectsNotification object:dataStore];
+    [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(dataStoreDidChangeObjects:) name:SCDataStoreDidChangeObjectsNotification object:dataStore];
     
     if(!dataFetchOptions)
         dataFetchOptions = [__dataStore.defaultDataDefinition generateCompatibleDataFetchOptions];
@@ -1345,6 +1532,138 @@
     itemsInSync = FALSE;
 }
 
+- (void)dataStoreDidChangeObjects:(NSNotification *)notification
+{
+    // Items that have not been fetched yet will be fetched fresh on next access anyway
+    if(!itemsInSync)
+        return;
+    
+    // Sections owned by SCArrayOfItemsModel get their items from the model, which applies the changes itself
+    if([self.ownerTableViewModel isKindOfClass:[SCArrayOfItemsModel class]])
+        return;
+    
+    UITableView *tableView = self.ownerTableViewModel.tableView;
+    NSUInteger sectionIndex = [self.ownerTableViewModel indexForSection:self];
+    
+    if(self.expandCollapseCell && !self.expandCollapseCell.ownerSectionExpanded)
+    {
+        // items are not displayed, refetch when expanded
+        itemsInSync = FALSE;
+        return;
+    }
+    
+    if([notification.userInfo objectForKey:SCDataStoreInvalidatedAllObjectsKey] || self.dataFetchOptions.batchSize)
+    {
+        // changes cannot be applied incrementally (new objects might belong to batches that have not been fetched yet)
+        [self reloadBoundValues];
+        if(tableView && sectionIndex!=NSNotFound)
+            [tableView reloadSections:[NSIndexSet indexSetWithIndex:sectionIndex] withRowAnimation:UITableViewRowAnimationNone];
+        return;
+    }
+    
+    NSArray *insertedObjects = [notification.userInfo objectForKey:SCDataStoreInsertedObjectsKey];
+    NSArray *updatedObjects = [notification.userInfo objectForKey:SCDataStoreUpdatedObjectsKey];
+    NSArray *deletedObjects = [notification.userInfo objectForKey:SCDataStoreDeletedObjectsKey];
+    for(NSObject *object in updatedObjects)
+        [_prefetchedCellTexts removeObjectForKey:object];
+    
+    NSArray *oldItems = [NSArray arrayWithArray:self.mutableItems];
+    NSObject *selectedItem = nil;
+    if(self.selectedCellIndexPath && self.selectedCellIndexPath.row<oldItems.count)
+        selectedItem = [oldItems objectAtIndex:self.selectedCellIndexPath.row];
+    
+    [self removeSpecialCellsFromItems];
+    
+    // only the changed objects are evaluated against the section's fetch options
+    for(NSObject *object in deletedObjects)
+        [self.mutableItems removeObjectIdenticalTo:object];
+    NSMutableArray *changedItems = [NSMutableArray array];
+    for(NSObject *object in [insertedObjects arrayByAddingObjectsFromArray:updatedObjects])
+    {
+        BOOL exists = [self.mutableItems indexOfObjectIdenticalTo:object] != NSNotFound;
+        BOOL passes = [self itemPassesDataFetchFilter:object];
+        
+        if(passes && !exists)
+            [self.mutableItems addObject:object];
+        else if(!passes && exists)
+            [self.mutableItems removeObjectIdenticalTo:object];
+        else if(passes)
+            [changedItems addObject:object];
+    }
+    if(self.dataFetchOptions.sort)
+        [self.dataFetchOptions sortMutableArray:self.mutableItems];
+    
+    [self addSpecialCellsToItems];
+    
+    NSArray *newItems = self.mutableItems;
+    if(!tableView || sectionIndex==NSNotFound || ([oldItems isEqualToArray:newItems] && !changedItems.count))
+        return;
+    
+    NSMutableArray *deletedIndexPaths = [NSMutableArray array];
+    NSMutableArray *insertedIndexPaths = [NSMutableArray array];
+    NSMutableArray *reloadedIndexPaths = [NSMutableArray array];
+    NSMutableArray *movedItems = [NSMutableArray array];
+    
+    for(NSUInteger i=0; i<oldItems.count; i++)
+    {
+        if([newItems indexOfObjectIdenticalTo:[oldItems objectAtIndex:i]] == NSNotFound)
+            [deletedIndexPaths addObject:[NSIndexPath indexPathForRow:i inSection:sectionIndex]];
+    }
+    for(NSUInteger i=0; i<newItems.count; i++)
+    {
+        if([oldItems indexOfObjectIdenticalTo:[newItems objectAtIndex:i]] == NSNotFound)
+            [insertedIndexPaths addObject:[NSIndexPath indexPathForRow:i inSection:sectionIndex]];
+    }
+    
+    [self.ownerTableViewModel clearLastReturnedCellData];
+    [tableView beginUpdates];
+    if(deletedIndexPaths.count)
+        [tableView deleteRowsAtIndexPaths:deletedIndexPaths withRowAnimation:UITableViewRowAnimationAutomatic];
+    if(insertedIndexPaths.count)
+        [tableView insertRowsAtIndexPaths:insertedIndexPaths withRowAnimation:UITableViewRowAnimationAutomatic];
+    // Only changed objects can change their relative sort order, all other rows simply shift
+    for(NSObject *item in changedItems)
+    {
+        NSUInteger oldIndex = [oldItems indexOfObjectIdenticalTo:item];
+        NSUInteger newIndex = [newItems indexOfObjectIdenticalTo:item];
+        NSIndexPath *oldIndexPath = [NSIndexPath indexPathForRow:oldIndex inSection:sectionIndex];
+        
+        if(oldIndex == newIndex)
+        {
+            [reloadedIndexPaths addObject:oldIndexPath];
+        }
+        else
+        {
+            [tableView moveRowAtIndexPath:oldIndexPath toIndexPath:[NSIndexPath indexPathForRow:newIndex inSection:sectionIndex]];
+            [movedItems addObject:item];
+        }
+    }
+    if(reloadedIndexPaths.count)
+        [tableView reloadRowsAtIndexPaths:reloadedIndexPaths withRowAnimation:UITableViewRowAnimationNone];
+    [tableView endUpdates];
+    
+    // moved rows cannot be reloaded within the same update block
+    if(movedItems.count)
+    {
+        NSMutableArray *movedIndexPaths = [NSMutableArray arrayWithCapacity:movedItems.count];
+        for(NSObject *item in movedItems)
+            [movedIndexPaths addObject:[NSIndexPath indexPathForRow:[newItems indexOfObjectIdenticalTo:item] inSection:sectionIndex]];
+        [tableView reloadRowsAtIndexPaths:movedIndexPaths withRowAnimation:UITableViewRowAnimationNone];
+    }
+    
+    // keep the selected row pointing at the same item
+    if(selectedItem)
+    {
+        NSUInteger selectedIndex = [newItems indexOfObjectIdenticalTo:selectedItem];
+        if(selectedIndex != NSNotFound)
+            self.selectedCellIndexPath = [NSIndexPath indexPathForRow:selectedIndex inSection:sectionIndex];
+        else
+            self.selectedCellIndexPath = nil;
+    }
+    
+    [self.ownerTableViewModel invalidateFocusableRows];
+}
+
 - (void)dataStoreWillDiscardUninsertedObjects
 {
     if(tempItem && activeDetailModel)
@@ -1411,7 +1730,11 @@
     if(cellHeight != UITableViewAutomaticDimension)
         return cellHeight;
     
-    cellHeight = [super heightForCellAtIndexPath:indexPath];
+    // Generated rows that aren't about to be displayed are measured using an offscreen prototype cell. Rows about to be displayed and special cells are measured directly, so that the model hands the measured cell to cellForRowAtIndexPath.
+    if(indexPath.row < self.items.count && ![[self.items objectAtIndex:indexPath.row] isKindOfClass:[SCTableViewCell class]] && ![self rowIsAboutToBeDisplayedAtIndexPath:indexPath])
+        cellHeight = [self prototypeHeightForCellAtIndexPath:indexPath];
+    else
+        cellHeight = [super heightForCellAtIndexPath:indexPath];
     
     return cellHeight;
 }
@@ -1424,6 +1747,19 @@
     [super setExpanded:expanded];
 }
 
+//overrides superclass
+- (BOOL)tracksCellValueStates
+{
+    // items are fetched directly into 'cells', so cell value states can't be tracked incrementally
+    return FALSE;
+}
+
+//overrides superclass
+- (BOOL)generatesCellsOnDemand
+{
+    return TRUE;
+}
+
 //overrides superclass
 - (NSMutableArray *)cells
 {
@@ -1478,11 +1814,22 @@
 
 - (void)fetchItems:(id)sender
 {
+    BOOL firstBatch = FALSE;
     if(self.dataFetchOptions.batchSize)
     {
         if(self.dataFetchOptions.batchCurrentOffset == self.dataFetchOptions.batchStartingOffset)
         {
             [cells removeAllObjects];
+            
+            firstBatch = TRUE;
+            _itemsTotalCount = NSNotFound;
+            _fetchedItemsCount = self.dataFetchOptions.batchStartingOffset*self.dataFetchOptions.batchSize;
+        }
+        else if(_itemsTotalCount!=NSNotFound && _fetchedItemsCount>=_itemsTotalCount)
+        {
+            // the store is known to have no more items, no need to ask it for an empty batch
+            [self didFetchItems:[NSArray array] sender:sender];
+            return;
         }
     }
     
@@ -1490,6 +1837,9 @@
     {
         case SCStoreModeSynchronous:
         {
+            if(firstBatch)
+                _itemsTotalCount = [self.dataStore countObjectsWithOptions:self.dataFetchOptions];
+            
             NSArray *array = [self.dataStore fetchObjectsWithOptions:self.dataFetchOptions];
          
             [self didFetchItems:array sender:sender];
@@ -1533,6 +1883,29 @@
              {
                  return NO;  // call failure_block
              }];
+            
+            if(firstBatch)
+            {
+                NSUInteger countGeneration = ++_itemsCountGeneration;
+                [self.dataStore asynchronousCountObjectsWithOptions:self.dataFetchOptions
+                success:^(NSUInteger count)
+                 {
+                     if(countGeneration != self->_itemsCountGeneration)
+                         return;    // a newer fetch has started since
+                     
+                     self->_itemsTotalCount = count;
+                     if(!self->_isFetchingItems)
+                         [self removeFetchItemsCellIfNoMoreItems];
+                 }
+                failure:^(NSError *error)
+                 {
+                     // keep determining available batches from the size of the last fetched batch
+                 }
+                noConnection:^BOOL()
+                 {
+                     return NO;  // call failure_block
+                 }];
+            }
             break;
     }
 }
@@ -1551,6 +1924,8 @@
     NSInteger insertionIndex = -1;
     if(self.dataFetchOptions.batchSize)
     {
+        _fetchedItemsCount += fetchedItems.count;
+        
         [self removeSpecialCellsFromItems];
         insertionIndex = cells.count;
         
@@ -1663,16 +2038,37 @@
     
     if(self.fetchItemsCell && self.dataFetchOptions.batchSize>0)
     {
-        if(!self.fetchItemsCell.autoHide 
-           || self.mutableItems.count==(self.dataFetchOptions.batchCurrentOffset*self.dataFetchOptions.batchSize))
+        if(!self.fetchItemsCell.autoHide)
         {
             exists = TRUE;
         }
+        else if(_itemsTotalCount != NSNotFound)
+        {
+            exists = (_fetchedItemsCount < _itemsTotalCount);
+        }
+        else if(self.mutableItems.count==(self.dataFetchOptions.batchCurrentOffset*self.dataFetchOptions.batchSize))
+        {
+            // a full last batch may or may not be followed by more items
+            exists = TRUE;
+        }
     }
     
     return exists;
 }
 
+- (void)removeFetchItemsCellIfNoMoreItems
+{
+    NSUInteger fetchItemsCellIndex = [self.mutableItems indexOfObjectIdenticalTo:self.fetchItemsCell];
+    if(fetchItemsCellIndex==NSNotFound || [self fetchItemsCellExists])
+        return;
+    
+    [self.mutableItems removeObjectAtIndex:fetchItemsCellIndex];
+    
+    NSUInteger sectionIndex = [self.ownerTableViewModel indexForSection:self];
+    if(sectionIndex != NSNotFound)
+        [self.ownerTableViewModel.tableView deleteRowsAtIndexPaths:[NSArray arrayWithObject:[NSIndexPath indexPathForRow:fetchItemsCellIndex inSection:sectionIndex]] withRowAnimation:UITableViewRowAnimationFade];
+}
+
 - (BOOL)addNewItemCellExists
 {
     return [self addNewItemCellExistsForEditingMode: (self.ownerTableViewModel.tableView.editing && self.ownerTableViewModel.viewController.editing)];
@@ -1830,21 +2226,7 @@
 	
     NSIndexPath *indexPath = [NSIndexPath indexPathForRow:index inSection:[self.ownerTableViewModel indexForSection:self]];
     
-	// Check if the user provides custom identifiers for cells
-	NSString *cellId = nil;
-    if(self.sectionActions.reuseIdentifierForRowAtIndexPath)
-    {
-        cellId = self.sectionActions.reuseIdentifierForRowAtIndexPath(self, indexPath);
-    }
-    else 
-        if(self.ownerTableViewModel.sectionActions.reuseIdentifierForRowAtIndexPath)
-        {
-            cellId = self.ownerTableViewModel.sectionActions.reuseIdentifierForRowAtIndexPath(self, indexPath);
-        }
-	if(!cellId)
-	{
-		cellId = self.cellIdentifier;
-	}
+	NSString *cellId = [self reuseIdentifierForCellAtIndexPath:indexPath];
 	
 	SCTableViewCell *cell = (SCTableViewCell *)[self.ownerTableViewModel.tableView 
                                                 dequeueReusableCellWithIdentifier:cellId];
@@ -1875,6 +2257,127 @@
     return cell;
 }
 
+- (NSString *)reuseIdentifierForCellAtIndexPath:(NSIndexPath *)indexPath
+{
+	// Check if the user provides custom identifiers for cells
+	NSString *cellId = nil;
+    if(self.sectionActions.reuseIdentifierForRowAtIndexPath)
+    {
+        cellId = self.sectionActions.reuseIdentifierForRowAtIndexPath(self, indexPath);
+    }
+    else 
+        if(self.ownerTableViewModel.sectionActions.reuseIdentifierForRowAtIndexPath)
+        {
+            cellId = self.ownerTableViewModel.sectionActions.reuseIdentifierForRowAtIndexPath(self, indexPath);
+        }
+	if(!cellId)
+	{
+		cellId = self.cellIdentifier;
+	}
+    
+    return cellId;
+}
+
+- (SCTableViewCell *)prototypeCellWithReuseIdentifier:(NSString *)cellId atIndexPath:(NSIndexPath *)indexPath
+{
+    SCTableViewCell *cell = [_prototypeCells objectForKey:cellId];
+    if(cell)
+    {
+        // undo whatever styling or configuration the previously measured row applied
+        cell.height = [[_prototypeAssignedHeights objectForKey:cellId] doubleValue];
+        return cell;
+    }
+    
+    // Create the prototype the same way unconfiguredCellAtIndex: creates new cells, but never dequeue it
+    if(self.sectionActions.cellForRowAtIndexPath)
+    {
+        cell = self.sectionActions.cellForRowAtIndexPath(self, indexPath);
+    }
+    else 
+        if(self.ownerTableViewModel.sectionActions.cellForRowAtIndexPath)
+        {
+            cell = self.ownerTableViewModel.sectionActions.cellForRowAtIndexPath(self, indexPath);
+        }
+    
+    if(cell)
+        cell.customCell = TRUE;
+    else 
+        cell = [self createCellAtIndex:indexPath.row usingCellId:cellId];
+    
+    cell.reuseId = cellId;
+    
+    [_prototypeCells setObject:cell forKey:cellId];
+    [_prototypeAssignedHeights setObject:[NSNumber numberWithDouble:[cell assignedHeight]] forKey:cellId];
+    
+    return cell;
+}
+
+- (BOOL)rowIsAboutToBeDisplayedAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSArray *visiblePaths = [self.ownerTableViewModel.tableView indexPathsForVisibleRows];
+    
+    // Nothing displayed yet: the table view only asks for the heights of the rows it's about to display (estimatedRowHeight is set)
+    if(!visiblePaths.count)
+        return TRUE;
+    
+    // Rows scrolling in are adjacent to the visible rows
+    NSIndexPath *firstVisiblePath = [visiblePaths objectAtIndex:0];
+    NSIndexPath *lastVisiblePath = [visiblePaths lastObject];
+    if(indexPath.section==firstVisiblePath.section && indexPath.row+1 < firstVisiblePath.row)
+        return FALSE;
+    if(indexPath.section==lastVisiblePath.section && indexPath.row > lastVisiblePath.row+1)
+        return FALSE;
+    
+    return (indexPath.section >= firstVisiblePath.section && indexPath.section <= lastVisiblePath.section);
+}
+
+- (CGFloat)prototypeHeightForCellAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSString *cellId = [self reuseIdentifierForCellAtIndexPath:indexPath];
+    SCTableViewCell *cell = [self prototypeCellWithReuseIdentifier:cellId atIndexPath:indexPath];
+    
+    // bind the prototype to the row's item, leaving any prefetched texts for the row's real cell
+    _bindingPrototypeCell = TRUE;
+    [self setPropertiesForCell:cell withIndex:indexPath.row];
+    _bindingPrototypeCell = FALSE;
+    
+    SCTableViewModel *model = self.ownerTableViewModel;
+    if(model.theme)
+    {
+        // the height a theme style assigns only depends on the cell type, unless a willStyle action customizes each row
+        BOOL stylesEachRow = cell.cellActions.willStyle || self.cellActions.willStyle || model.cellActions.willStyle;
+        NSString *themeStyle = [model themeStyleForCell:cell atIndexPath:indexPath];
+        NSString *styledHeightKey = [NSString stringWithFormat:@"%@|%@", cellId, themeStyle ? themeStyle : @""];
+        NSNumber *styledHeight = stylesEachRow ? nil : [_prototypeStyledHeights objectForKey:styledHeightKey];
+        if(styledHeight)
+        {
+            cell.height = [styledHeight doubleValue];
+        }
+        else
+        {
+            [model styleCell:cell atIndexPath:indexPath onlyStylePropertyNamesInSet:[NSSet setWithObject:@"height"]];
+            if(!stylesEachRow)
+                [_prototypeStyledHeights setObject:[NSNumber numberWithDouble:[cell assignedHeight]] forKey:styledHeightKey];
+        }
+    }
+    [model configureCell:cell atIndexPath:indexPath];
+    cell.configured = FALSE;  // prototypes are configured again for every row they measure
+    
+    CGFloat cellHeight = cell.height;
+    // Check if the cell has an image in its section and resize accordingly
+    if([self.cellsImageViews count] > indexPath.row)
+    {
+        UIImageView *imageView = [self.cellsImageViews objectAtIndex:indexPath.row];
+        if([imageView isKindOfClass:[UIImageView class]])
+        {
+            if(cellHeight < imageView.image.size.height)
+                cellHeight = imageView.image.size.height;
+        }
+    }
+    
+    return cellHeight;
+}
+
 // override superclass method
 - (SCTableViewCell *)cellAtIndex:(NSUInteger)index
 {
@@ -1909,7 +2412,10 @@
     
     itemsInSync = FALSE;
     [self.mutableItems removeAllObjects];
+    [_prefetchedCellTexts removeAllObjects];
+    [_prototypeStyledHeights removeAllObjects];
     [self.dataFetchOptions resetBatchOffset];
+    _itemsTotalCount = NSNotFound;
     
     
     if([self.ownerTableViewModel.viewController isKindOfClass:[SCTableViewController class]])
@@ -1944,8 +2450,36 @@
         cell.beingReused = TRUE;
         if((NSInteger)cell.cellStyle!=-1 || [cell.textLabel.text length])  // -1 is custom cell style
         {
-            cell.textLabel.text = [self textForCellAtIndex:index];
-            cell.detailTextLabel.text = [self detailTextForCellAtIndex:index];
+            NSArray *prefetchedTexts = [_prefetchedCellTexts objectForKey:item];
+            if(prefetchedTexts)
+            {
+                if(!_bindingPrototypeCell)
+                    [_prefetchedCellTexts removeObjectForKey:item];
+                
+                NSObject *text = [prefetchedTexts objectAtIndex:0];
+                NSObject *detailText = [prefetchedTexts objectAtIndex:1];
+                cell.textLabel.text = (text==[NSNull null]) ? nil : (NSString *)text;
+                cell.detailTextLabel.text = (detailText==[NSNull null]) ? nil : (NSString *)detailText;
+            }
+            else
+            {
+                cell.textLabel.text = [self textForCellAtIndex:index];
+                cell.detailTextLabel.text = [self detailTextForCellAtIndex:index];
+            }
+        }
+        
+        if(!_imagePropertyNames && [cell isKindOfClass:[SCCustomCell class]])
+        {
+            // remember which item properties are loaded into image views so that they can be prefetched
+            SCCustomCell *customCell = (SCCustomCell *)cell;
+            NSMutableArray *imagePropertyNames = [NSMutableArray array];
+            for(NSString *controlTag in customCell.objectBindings)
+            {
+                UIView *control = [customCell.contentView viewWithTag:[controlTag integerValue]];
+                if([control isKindOfClass:[UIImageView class]])
+                    [imagePropertyNames addObject:[customCell.objectBindings objectForKey:controlTag]];
+            }
+            _imagePropertyNames = imagePropertyNames;
         }
         BOOL allowMoving = self.allowMovingItems && [self.dataStore validateOrderChangeForObject:item];
         cell.editable = (self.allowDeletingItems || allowMoving);
@@ -1984,6 +2518,117 @@
         cell.boundPropertyName = [SCUtilities dataStructureNameForClass:[item class]];
 }
 
+// override superclass method
+- (NSArray *)observedKeyPathsForCell:(SCTableViewCell *)cell
+{
+    NSArray *cellKeyPaths = [super observedKeyPathsForCell:cell];
+    if(cell.isSpecialCell || !cell.boundObject || [cell.boundObject isKindOfClass:[NSDictionary class]])
+        return cellKeyPaths;
+    
+    // generated cells display the item's title and description
+    SCDataDefinition *objectDefinition = [self.dataStore definitionForObject:cell.boundObject];
+    NSMutableArray *keyPaths = [NSMutableArray arrayWithArray:cellKeyPaths];
+    for(NSString *propertyNames in [NSArray arrayWithObjects:(objectDefinition.titlePropertyName ?: @""), (objectDefinition.descriptionPropertyName ?: @""), nil])
+    {
+        for(NSString *propertyName in [propertyNames componentsSeparatedByString:@";"])
+        {
+            NSString *keyPath = [propertyName stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+            if([keyPath length] && ![keyPaths containsObject:keyPath])
+                [keyPaths addObject:keyPath];
+        }
+    }
+    
+    return keyPaths;
+}
+
+// override superclass method
+- (void)prefetchCellsAtIndexes:(NSIndexSet *)indexes
+{
+    // items that haven't been fetched yet are fetched when the section is first displayed
+    if(!itemsInSync || (self.expandCollapseCell && !self.expandCollapseCell.ownerSectionExpanded))
+        return;
+    
+    NSArray *items = self.mutableItems;
+    NSMutableArray *prefetchItems = [NSMutableArray array];
+    BOOL fetchNextBatch = FALSE;
+    for(NSUInteger index=[indexes firstIndex]; index!=NSNotFound && index<items.count; index=[indexes indexGreaterThanIndex:index])
+    {
+        NSObject *item = [items objectAtIndex:index];
+        if([item isKindOfClass:[SCTableViewCell class]])
+        {
+            if(item==self.fetchItemsCell && self.fetchItemsCell.autoFetchItems && !_isFetchingItems
+               && (_itemsTotalCount==NSNotFound || _fetchedItemsCount<_itemsTotalCount))
+                fetchNextBatch = TRUE;
+            continue;
+        }
+        
+        [prefetchItems addObject:item];
+    }
+    
+    // load all the items' data in a single batch before resolving any of their values
+    [self.dataStore prefetchObjects:prefetchItems];
+    
+    for(NSUInteger index=[indexes firstIndex]; index!=NSNotFound && index<items.count; index=[indexes indexGreaterThanIndex:index])
+    {
+        NSObject *item = [items objectAtIndex:index];
+        if([item isKindOfClass:[SCTableViewCell class]] || [_prefetchedCellTexts objectForKey:item])
+            continue;
+        
+        NSString *text = [self textForCellAtIndex:index];
+        NSString *detailText = [self detailTextForCellAtIndex:index];
+        [_prefetchedCellTexts setObject:[NSArray arrayWithObjects:(text ?: [NSNull null]), (detailText ?: [NSNull null]), nil] forKey:item];
+        
+        for(NSURL *imageURL in [self imageURLsForItem:item])
+            [SCUtilities prefetchImageWithURL:imageURL];
+    }
+    
+    if(fetchNextBatch)
+    {
+        // warm the next batch before the fetch cell scrolls into view
+        [NSObject cancelPreviousPerformRequestsWithTarget:self.fetchItemsCell selector:@selector(fetchItems) object:nil];
+        [self.fetchItemsCell performSelector:@selector(fetchItems) withObject:nil afterDelay:0];
+    }
+}
+
+// override superclass method
+- (void)cancelPrefetchingCellsAtIndexes:(NSIndexSet *)indexes
+{
+    if(!itemsInSync)
+        return;
+    
+    NSArray *items = self.mutableItems;
+    for(NSUInteger index=[indexes firstIndex]; index!=NSNotFound && index<items.count; index=[indexes indexGreaterThanIndex:index])
+    {
+        NSObject *item = [items objectAtIndex:index];
+        if([item isKindOfClass:[SCTableViewCell class]])
+        {
+            if(item==self.fetchItemsCell && !_isFetchingItems)
+                [NSObject cancelPreviousPerformRequestsWithTarget:self.fetchItemsCell selector:@selector(fetchItems) object:nil];
+            continue;
+        }
+        
+        [_prefetchedCellTexts removeObjectForKey:item];
+        for(NSURL *imageURL in [self imageURLsForItem:item])
+            [SCUtilities cancelImagePrefetchWithURL:imageURL];
+    }
+}
+
+- (NSArray *)imageURLsForItem:(NSObject *)item
+{
+    if(!_imagePropertyNames.count)
+        return nil;
+    
+    NSMutableArray *imageURLs = [NSMutableArray array];
+    for(NSString *propertyName in _imagePropertyNames)
+    {
+        NSObject *value = [self.dataStore valueForPropertyName:propertyName inObject:item];
+        if([value isKindOfClass:[NSString class]] && [SCUtilities isURLValid:(NSString *)value])
+            [imageURLs addObject:[NSURL URLWithString:(NSString *)value]];
+    }
+    
+    return imageURLs;
+}
+
 - (NSString *)textForCellAtIndex:(NSUInteger)index
 {
 	NSObject *object = [self.items objectAtIndex:index];
@@ -2201,6 +2846,24 @@
     else 
         detailOptions = self.detailViewControllerOptions;
     
+    BOOL reusedDetailModel = FALSE;
+    if(!detailViewController && detailOptions.reuseDetailViewControllers && !self.sectionActions.detailTableViewModelForRowAtIndexPath && !self.ownerTableViewModel.sectionActions.detailTableViewModelForRowAtIndexPath)
+    {
+        SCTableViewController *reusableViewController = [self dequeueReusableDetailViewControllerForItem:item newItem:newItem];
+        if(!reusableViewController)
+        {
+            reusableViewController = [[SCTableViewController alloc] initWithStyle:detailOptions.tableViewStyle];
+            [[self detailViewControllerPoolForItem:item] setObject:reusableViewController forKey:[self detailViewControllerPoolKeyForItem:item newItem:newItem]];
+        }
+        else
+        {
+            // cells generated for a previous item can be rebound, unless they were generated for editing mode
+            reusedDetailModel = (!reusableViewController.tableView.editing && [self canRebindDetailModel:reusableViewController.tableViewModel]);
+        }
+        
+        detailViewController = reusableViewController;
+    }
+    
     if(!detailViewController)
         detailViewController = [[SCTableViewController alloc] initWithStyle:detailOptions.tableViewStyle];
     detailViewController.modalPresentationStyle = detailOptions.modalPresentationStyle;
@@ -2250,12 +2913,125 @@
     
     [self configureDetailViewController:detailViewController item:item newItem:newItem];
     [self.ownerTableViewModel configureDetailModel:detailModel];
-	[self buildDetailTableModel:detailModel	forItem:item];
-    [self configureDetailTableModel:detailModel forItem:item];
+    if(reusedDetailModel)
+    {
+        [self configureDetailTableModel:detailModel forItem:item];
+        [detailModel reloadBoundValues];
+        
+        // discard any commit state left over from a cancelled session
+        for(NSUInteger i=0; i<detailModel.sectionCount; i++)
+        {
+            SCTableViewSection *section = [detailModel sectionAtIndex:i];
+            for(NSUInteger j=0; j<section.cellCount; j++)
+                [[section cellAtIndex:j] setNeedsCommit:FALSE];
+        }
+        [detailModel invalidateCellValueStates];
+    }
+    else
+    {
+        [self buildDetailTableModel:detailModel	forItem:item];
+        [self configureDetailTableModel:detailModel forItem:item];
+    }
     
     return detailViewController;
 }
 
+- (NSMutableDictionary *)detailViewControllerPoolForItem:(NSObject *)item
+{
+    if(!_detailViewControllerPool)
+        _detailViewControllerPool = [NSMapTable mapTableWithKeyOptions:(NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality) valueOptions:NSPointerFunctionsStrongMemory];
+    
+    // pools are keyed by the definition itself so that they go away with it
+    id itemDefinition = [self.dataStore definitionForObject:item];
+    if(!itemDefinition)
+        itemDefinition = [NSNull null];
+    
+    NSMutableDictionary *pool = [_detailViewControllerPool objectForKey:itemDefinition];
+    if(!pool)
+    {
+        pool = [NSMutableDictionary dictionary];
+        [_detailViewControllerPool setObject:pool forKey:itemDefinition];
+    }
+    
+    return pool;
+}
+
+- (NSString *)detailViewControllerPoolKeyForItem:(NSObject *)item newItem:(BOOL)newItem
+{
+    SCDetailViewControllerOptions *detailOptions = newItem ? self.newItemDetailViewControllerOptions : self.detailViewControllerOptions;
+    
+    return [NSString stringWithFormat:@"%ld-%d", (long)detailOptions.presentationMode, newItem];
+}
+
+- (BOOL)canRebindDetailModel:(SCTableViewModel *)detailModel
+{
+    if(!detailModel.sectionCount)
+        return FALSE;
+    
+    // sections generated for relationship properties (e.g. SCArrayOfObjectsSection) are bound to the previous item's stores
+    for(NSUInteger i=0; i<detailModel.sectionCount; i++)
+    {
+        if(![[detailModel sectionAtIndex:i] isMemberOfClass:[SCObjectSection class]])
+            return FALSE;
+    }
+    
+    return TRUE;
+}
+
+- (SCTableViewController *)dequeueReusableDetailViewControllerForItem:(NSObject *)item newItem:(BOOL)newItem
+{
+    NSString *poolKey = [self detailViewControllerPoolKeyForItem:item newItem:newItem];
+    SCTableViewController *viewController = [[self detailViewControllerPoolForItem:item] objectForKey:poolKey];
+    if(!viewController)
+        return nil;
+    
+    // Make sure the view controller isn't still being displayed
+    if(viewController.parentViewController || viewController.presentingViewController || viewController.state==SCViewControllerStateActive)
+        return nil;
+    
+    [viewController prepareForReuse];
+    
+    return viewController;
+}
+
+- (void)prewarmDetailViewController
+{
+    if(!self.detailViewControllerOptions.reuseDetailViewControllers)
+        return;
+    
+    // Only run when the main run loop is idle (i.e. not while the user is scrolling)
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(generatePrewarmedDetailViewController) object:nil];
+    [self performSelector:@selector(generatePrewarmedDetailViewController) withObject:nil afterDelay:0 inModes:[NSArray arrayWithObject:NSDefaultRunLoopMode]];
+}
+
+- (void)generatePrewarmedDetailViewController
+{
+    NSObject *firstItem = nil;
+    for(NSObject *item in self.items)
+    {
+        if(![item isKindOfClass:[SCTableViewCell class]])
+        {
+            firstItem = item;
+            break;
+        }
+    }
+    if(!firstItem)
+        return;
+    
+    if([self dequeueReusableDetailViewControllerForItem:firstItem newItem:NO])
+        return;     // already warm
+    
+    SCTableViewController *viewController = [[SCTableViewController alloc] initWithStyle:self.detailViewControllerOptions.tableViewStyle];
+    [viewController view];  // load the view and its table view ahead of time
+    
+    // generate the detail cells now, so that the first tap only has to rebind them
+    self.buildingPrewarmedDetailModel = TRUE;
+    [self buildDetailTableModel:viewController.tableViewModel forItem:firstItem];
+    self.buildingPrewarmedDetailModel = FALSE;
+    
+    [[self detailViewControllerPoolForItem:firstItem] setObject:viewController forKey:[self detailViewControllerPoolKeyForItem:firstItem newItem:NO]];
+}
+
 - (void)configureDetailViewController:(UIViewController *)detailViewController item:(NSObject *)item newItem:(BOOL)newItem
 {
     SCDetailViewControllerOptions *detailOptions;
@@ -2980,6 +3756,8 @@
 
 - (void)itemModified:(NSObject *)item
 {
+    [_prefetchedCellTexts removeObjectForKey:item];
+    
 	if([SCUtilities isBasicDataTypeClass:[item class]])
     {
         // must reload array as item has been replaced (not modified)
@@ -3403,7 +4181,7 @@
     [detailTableModel clear];
     
     BOOL newObject;
-    if(self.selectedCellIndexPath)
+    if(self.selectedCellIndexPath || self.buildingPrewarmedDetailModel)
         newObject = FALSE;
     else
         newObject = TRUE;
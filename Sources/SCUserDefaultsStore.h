@@ -26,4 +26,23 @@
 /** The user defaults object managed by the data store. */
 @property (nonatomic, readonly) NSUserDefaults *standardUserDefaultsObject;
 
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/// @name Editing Sessions
+//////////////////////////////////////////////////////////////////////////////////////////
+
+/** Values set through the store are kept in an in-memory overlay that answers all reads, and are written to the user defaults object as a single batch. Outside an editing session, the batch is written at the end of the current run loop turn. 
+ 
+ Call this method to start collecting values until either commitEditingSession or discardEditingSession is called. SCTableViewModel automatically starts a session when a cell bound to the store is first edited in a view controller that has a Cancel button, and commits or discards it when the Done or Cancel button is tapped. */
+- (void)beginEditingSession;
+
+/** Ends the current editing session and writes all its values to the user defaults object as a single batch. */
+- (void)commitEditingSession;
+
+/** Ends the current editing session and discards all its values without writing them. Any cells displaying these values should be reloaded (e.g. using [SCTableViewModel reloadBoundValues]). */
+- (void)discardEditingSession;
+
+/** Returns TRUE if an editing session is currently in progress. */
+@property (nonatomic, readonly) BOOL inEditingSession;
+
 @end
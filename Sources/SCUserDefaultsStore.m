@@ -10,8 +10,38 @@
 
 #import "SCUserDefaultsStore.h"
 
+
+@interface SCUserDefaultsStore ()
+{
+    NSMutableDictionary *_pendingValues;    // values not yet written to the user defaults (NSNull for removed values)
+    BOOL _inEditingSession;
+    BOOL _writeScheduled;
+}
+
+- (NSDictionary *)dequeuePendingValues;
+- (void)writePendingValues;
+- (void)writeValues:(NSDictionary *)values;
+
+@end
+
+
+
 @implementation SCUserDefaultsStore
 
+@synthesize inEditingSession = _inEditingSession;
+
+
+- (instancetype)init
+{
+    if( (self = [super init]) )
+    {
+        _pendingValues = [[NSMutableDictionary alloc] init];
+        _inEditingSession = FALSE;
+        _writeScheduled = FALSE;
+    }
+    return self;
+}
+
 - (NSUserDefaults *)standardUserDefaultsObject
 {
     return [NSUserDefaults standardUserDefaults];
@@ -37,10 +67,100 @@
     return [NSArray arrayWithObject:self.standardUserDefaultsObject];
 }
 
+// overrides superclass
+- (NSObject *)valueForPropertyName:(NSString *)propertyName inObject:(NSObject *)object
+{
+    NSObject *pendingValue = nil;
+    if(_pendingValues.count && propertyName && [object isKindOfClass:[NSUserDefaults class]])
+        pendingValue = [_pendingValues objectForKey:propertyName];
+    
+    if(!pendingValue)
+        return [super valueForPropertyName:propertyName inObject:object];
+    
+    //else
+    if([pendingValue isKindOfClass:[NSNull class]])
+        return [self.defaultsDictionary valueForKey:propertyName];
+    return pendingValue;
+}
+
+// overrides superclass
+- (void)setValue:(NSObject *)value forPropertyName:(NSString *)propertyName inObject:(NSObject *)object
+{
+    if(!propertyName || ![object isKindOfClass:[NSUserDefaults class]])
+    {
+        [super setValue:value forPropertyName:propertyName inObject:object];
+        return;
+    }
+    
+    if(!value)
+        value = [NSNull null];
+    [_pendingValues setObject:value forKey:propertyName];
+    
+    // coalesce all writes in this run loop turn into a single batch
+    if(!_inEditingSession && !_writeScheduled)
+    {
+        _writeScheduled = TRUE;
+        [self performSelector:@selector(writePendingValues) withObject:nil afterDelay:0];
+    }
+}
+
+- (void)beginEditingSession
+{
+    _inEditingSession = TRUE;
+}
+
+- (void)commitEditingSession
+{
+    _inEditingSession = FALSE;
+    
+    [self writePendingValues];
+}
+
+- (void)discardEditingSession
+{
+    _inEditingSession = FALSE;
+    
+    [_pendingValues removeAllObjects];
+}
+
+- (NSDictionary *)dequeuePendingValues
+{
+    NSDictionary *values = [_pendingValues copy];
+    [_pendingValues removeAllObjects];
+    
+    return values;
+}
+
+- (void)writePendingValues
+{
+    _writeScheduled = FALSE;
+    
+    if(_inEditingSession || !_pendingValues.count)
+        return;
+    
+    // NSUserDefaults posts KVO and change notifications on the calling thread, so write on the main thread
+    [self writeValues:[self dequeuePendingValues]];
+}
+
+- (void)writeValues:(NSDictionary *)values
+{
+    NSUserDefaults *userDefaults = self.standardUserDefaultsObject;
+    for(NSString *key in values)
+    {
+        NSObject *value = [values objectForKey:key];
+        if([value isKindOfClass:[NSNull class]])
+            [userDefaults removeObjectForKey:key];
+        else
+            [userDefaults setObject:value forKey:key];
+    }
+}
+
 // overrides superclass
 - (void)commitData
 {
-    [self.standardUserDefaultsObject synchronize];
+    // Called when the app enters the background or terminates, so write any pending values right away.
+    // The user defaults system persists them on its own, there is no need to call the blocking synchronize.
+    [self writePendingValues];
 }
 
 @end
@@ -643,6 +643,11 @@
         return;
     }
     
+    if(cancelValue)
+        [self.tableViewModel discardEditingSessions];
+    else
+        [self.tableViewModel commitEditingSessions];
+    
     
     if(_hasFocus)
     {